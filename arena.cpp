@@ -0,0 +1,150 @@
+#include <new>
+#include <utility>
+
+#include "arena.hpp"
+
+node_arena::node_arena(size_t chunk_nodes)
+    : chunk_nodes(chunk_nodes ? chunk_nodes : 1), count(0)
+{
+}
+
+node_arena::~node_arena() { release(); }
+
+node_arena::node_arena(node_arena&& other) noexcept
+    : chunks(std::move(other.chunks)), chunk_nodes(other.chunk_nodes),
+      count(other.count)
+{
+    other.chunks.clear();
+    other.count = 0;
+}
+
+node_arena& node_arena::operator=(node_arena&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        chunks = std::move(other.chunks);
+        chunk_nodes = other.chunk_nodes;
+        count = other.count;
+        other.chunks.clear();
+        other.count = 0;
+    }
+    return *this;
+}
+
+void node_arena::add_chunk(size_t cap)
+{
+    void* mem = ::operator new(cap * sizeof(node));
+    chunks.push_back({static_cast<node*>(mem), cap, 0});
+}
+
+node* node_arena::make(int data)
+{
+    if (chunks.empty() || chunks.back().used == chunks.back().cap) {
+        add_chunk(chunk_nodes);
+    }
+    ++count;
+    chunk& c = chunks.back();
+    return ::new (c.mem + c.used++) node(data);
+}
+
+void node_arena::reserve(size_t n)
+{
+    if (chunks.empty() || chunks.back().cap - chunks.back().used < n) {
+        add_chunk(n > chunk_nodes ? n : chunk_nodes);
+    }
+}
+
+// nodes hold no resources of their own so no destructors are run; running
+// `~node` here would walk (and double free) the lists.
+void node_arena::release()
+{
+    for (chunk& c : chunks) {
+        ::operator delete(c.mem);
+    }
+    chunks.clear();
+    count = 0;
+}
+
+#ifdef TESTING
+#include "doctest.h"
+
+TEST_CASE("node_arena")
+{
+    SUBCASE("make")
+    {
+        node_arena arena(4);
+        node* a = arena.make(1);
+        node* b = arena.make(2);
+        CHECK(a->data == 1);
+        CHECK(a->next == a);
+        CHECK(b == a + 1);
+        CHECK(arena.size() == 2);
+        arena.release();
+        CHECK(arena.size() == 0);
+    }
+    SUBCASE("many-chunks")
+    {
+        node_arena arena(3);
+        for (int i = 0; i < 100; ++i) {
+            CHECK(arena.make(i)->data == i);
+        }
+        CHECK(arena.size() == 100);
+    }
+    SUBCASE("make_list(size_t)")
+    {
+        node_arena arena(2);
+        CHECK(make_list(0, arena) == nullptr);
+        node* foo = make_list(5, arena);
+        CHECK(node::size(foo) == 5);
+        for (size_t i = 0; i < 5; ++i) {
+            // reserved up front so the list is contiguous in list order
+            CHECK(node::at(foo, i) == foo + i);
+            CHECK(node::at(foo, i)->data == int(i));
+        }
+        CHECK_THROWS(node::at(foo, 5));
+    }
+    SUBCASE("make_list(initializer_list<int>)")
+    {
+        node_arena arena;
+        CHECK(make_list({}, arena) == nullptr);
+        node* foo = make_list({4, 3, 2, 1, 0}, arena);
+        CHECK(node::size(foo) == 5);
+        for (size_t i = 0; i < 5; ++i) {
+            CHECK(node::at(foo, i) == foo + i);
+            CHECK(node::at(foo, i)->data == 4 - int(i));
+        }
+    }
+    SUBCASE("jumped-release")
+    {
+        // the arena replaces do_jumped_delete
+        node_arena arena;
+        node* foo = make_list(1000, arena);
+        auto refs = do_ptr_jump(foo);
+        CHECK(refs.size() == 1000);
+        CHECK(refs[0]->next == refs.back());
+        arena.release();
+    }
+    SUBCASE("for_each")
+    {
+        // reserving skips the rest of a partly used chunk
+        node_arena arena(4);
+        arena.make(0);
+        node* foo = make_list({1, 2, 3, 4, 5}, arena);
+        arena.make(6);
+        std::vector<int> seen;
+        arena.for_each([&](node* n) { seen.push_back(n->data); });
+        CHECK(seen == std::vector<int>{0, 1, 2, 3, 4, 5, 6});
+        CHECK(node::size(foo) == 5);
+    }
+    SUBCASE("move")
+    {
+        node_arena arena;
+        node* foo = make_list(10, arena);
+        node_arena other(std::move(arena));
+        CHECK(arena.size() == 0);
+        CHECK(other.size() == 10);
+        CHECK(node::size(foo) == 10);
+    }
+}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "linked_list.hpp"
+
+// bump allocator for nodes.
+//
+// nodes are placed back to back in large chunks and are never freed
+// individually; `release` (or destroying the arena) frees them all at once.
+// nodes from an arena must not be passed to `delete` or to
+// `do_jumped_delete(std::vector<node*>&)`; free jumped arena lists with
+// `do_jumped_delete(node_arena&)` instead.
+class node_arena {
+public:
+    // `chunk_nodes` is the number of nodes in each chunk the arena allocates.
+    explicit node_arena(size_t chunk_nodes = 1 << 16);
+    ~node_arena();
+
+    node_arena(const node_arena&) = delete;
+    node_arena& operator=(const node_arena&) = delete;
+    node_arena(node_arena&& other) noexcept;
+    node_arena& operator=(node_arena&& other) noexcept;
+
+    // constructs a new self-looped node in the arena.
+    node* make(int data);
+
+    // ensures the next `n` nodes made are contiguous in memory.
+    void reserve(size_t n);
+
+    // frees every node in the arena at once.
+    void release();
+
+    // the number of nodes made since the last release.
+    size_t size() const { return count; }
+
+    // calls `fn(node*)` on every node made since the last release, in
+    // allocation order.
+    template<class F>
+    void for_each(F fn) const
+    {
+        for (const chunk& c : chunks) {
+            for (size_t i = 0; i < c.used; ++i) {
+                fn(c.mem + i);
+            }
+        }
+    }
+
+private:
+    struct chunk {
+        node* mem;
+        size_t cap;
+        size_t used;
+    };
+
+    void add_chunk(size_t cap);
+
+    std::vector<chunk> chunks;
+    size_t chunk_nodes;
+    size_t count;
+};
+
+#endif
@@ -0,0 +1,985 @@
+#ifdef BENCHMARK
+
+#include "arena.hpp"
+#include "compact.hpp"
+#include "forest.hpp"
+#include "index_list.hpp"
+#include "linked_list.hpp"
+#include "list.hpp"
+#include "list_rank.hpp"
+#include "list_scan.hpp"
+#include "node_pool.hpp"
+#include "parallel.hpp"
+#include "simd_jump.hpp"
+#include "skip_index.hpp"
+#include "successor_table.hpp"
+#include "traversal.hpp"
+#include "unrolled_list.hpp"
+#include "verify.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <numeric>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <random>
+
+#include <pthread.h>
+#include <sys/resource.h>
+
+// every heap allocation in the benchmark binary is counted.
+static std::atomic<size_t> alloc_count{0};
+static std::atomic<size_t> alloc_bytes{0};
+
+void* operator new(size_t sz)
+{
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes.fetch_add(sz, std::memory_order_relaxed);
+    if (void* p = std::malloc(sz ? sz : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+// kept out of line: once inlined next to the matching operator new, gcc 12
+// mistakes the free() for a mismatched deallocation
+__attribute__((noinline)) void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void* operator new(size_t sz, std::align_val_t al)
+{
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes.fetch_add(sz, std::memory_order_relaxed);
+    size_t align = static_cast<size_t>(al);
+    // aligned_alloc needs a multiple of the alignment
+    if (void* p = std::aligned_alloc(align, (sz + align - 1) / align * align)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+// resets the peak resident set size so each measurement reports its own.
+// linux only; elsewhere the peak is for the whole run.
+static void reset_peak_rss()
+{
+    if (std::FILE* f = std::fopen("/proc/self/clear_refs", "w")) {
+        std::fputs("5", f);
+        std::fclose(f);
+    }
+}
+
+// peak resident set size since the last reset, in KiB
+static long peak_rss_kb()
+{
+    long kb = -1;
+    if (std::FILE* f = std::fopen("/proc/self/status", "r")) {
+        char line[256];
+        while (std::fgets(line, sizeof(line), f)) {
+            if (std::sscanf(line, "VmHWM: %ld", &kb) == 1) {
+                break;
+            }
+        }
+        std::fclose(f);
+    }
+    if (kb < 0) {
+        rusage ru;
+        getrusage(RUSAGE_SELF, &ru);
+        kb = ru.ru_maxrss;
+    }
+    return kb;
+}
+
+using bench_clock = std::chrono::steady_clock;
+
+// times one benchmark case and counts the allocations made during it.
+class timer {
+public:
+    timer() { restart(); }
+
+    void restart()
+    {
+        allocs = alloc_count.load();
+        bytes = alloc_bytes.load();
+        reset_peak_rss();
+        t0 = bench_clock::now();
+    }
+
+    // prints one csv row for `items` operations on a list of `n` nodes
+    void report(const char* name, size_t n, size_t items)
+    {
+        double secs =
+            std::chrono::duration<double>(bench_clock::now() - t0).count();
+        std::printf("%s,%zu,%zu,%.9f,%.3f,%zu,%zu,%ld\n", name, n, items, secs,
+                    items ? secs * 1e9 / items : 0.0, alloc_count.load() - allocs,
+                    alloc_bytes.load() - bytes, peak_rss_kb());
+        std::fflush(stdout);
+    }
+
+    void report(const char* name, size_t n) { report(name, n, n); }
+
+private:
+    bench_clock::time_point t0;
+    size_t allocs;
+    size_t bytes;
+};
+
+static void print_header()
+{
+    std::printf("benchmark,nodes,items,seconds,ns_per_item,allocs,alloc_bytes,"
+                "peak_rss_kb\n");
+}
+
+// streambuf that throws away what is written to it
+class null_buf : public std::streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char*, std::streamsize n) override
+    {
+        return n;
+    }
+};
+
+// the basic list operations
+static void bench_core(size_t n)
+{
+    volatile size_t sink = 0;
+
+    timer t;
+    node* lst = make_list(n);
+    t.report("make_list", n);
+
+    t.restart();
+    sink = node::size(lst);
+    t.report("node::size", n);
+
+    t.restart();
+    sink = node::at(lst, n - 1)->data;
+    t.report("node::at/last", n);
+
+    null_buf buf;
+    std::ostream out(&buf);
+    t.restart();
+    out << lst;
+    t.report("operator<<", n);
+
+    t.restart();
+    auto refs = do_ptr_jump(lst);
+    t.report("do_ptr_jump", n);
+
+    t.restart();
+    do_jumped_delete(refs);
+    t.report("do_jumped_delete", n);
+
+    lst = make_list(n);
+    t.restart();
+    delete lst;
+    t.report("~node", n);
+    (void)sink;
+}
+
+// the original recursive implementation of pointer jumping, kept here as the
+// baseline for comparison.
+static node* rec_jump(node* n, std::vector<node*>& refs)
+{
+    refs.push_back(n);
+    if (n == n->next) {
+        return n;
+    }
+    else {
+        n->next = rec_jump(n->next, refs);
+        return n->next;
+    }
+}
+
+struct rec_jump_args {
+    node* start;
+    std::vector<node*>* refs;
+};
+
+static void* rec_jump_thread(void* p)
+{
+    auto* args = static_cast<rec_jump_args*>(p);
+    rec_jump(args->start, *args->refs);
+    return nullptr;
+}
+
+// largest list the recursive baseline is run on; beyond this the stack it
+// needs is unreasonable.
+static const size_t REC_JUMP_MAX = 8'000'000;
+
+// runs the recursive baseline on a thread with a stack big enough for `n`
+// frames. returns false if the list is too long to attempt.
+static bool rec_ptr_jump(node* start, size_t n, std::vector<node*>& refs)
+{
+    if (n > REC_JUMP_MAX) {
+        return false;
+    }
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, (n + 1024) * 128);
+    rec_jump_args args{start, &refs};
+    pthread_t tid;
+    bool ok = pthread_create(&tid, &attr, rec_jump_thread, &args) == 0;
+    if (ok) {
+        pthread_join(tid, nullptr);
+    }
+    pthread_attr_destroy(&attr);
+    return ok;
+}
+
+// the recursive baseline for do_ptr_jump
+static void bench_rec_jump(size_t n)
+{
+    {
+        node* lst = make_list(n);
+        std::vector<node*> refs;
+        timer t;
+        if (rec_ptr_jump(lst, n, refs)) {
+            t.report("rec_jump_baseline", n);
+            do_jumped_delete(refs);
+        }
+        else {
+            std::fprintf(stderr, "rec_jump_baseline: skipped at %zu nodes\n",
+                         n);
+            refs = do_ptr_jump(lst);
+            do_jumped_delete(refs);
+        }
+    }
+}
+
+// powers of two up to the hardware concurrency, then the concurrency
+static std::vector<unsigned> thread_counts()
+{
+    std::vector<unsigned> counts;
+    for (unsigned c = 1; c < default_threads(); c *= 2) {
+        counts.push_back(c);
+    }
+    counts.push_back(default_threads());
+    return counts;
+}
+
+static void bench_ptr_jump_parallel(size_t n)
+{
+    char name[32];
+    for (unsigned threads : thread_counts()) {
+        node* lst = make_list(n);
+        timer t;
+        auto refs = do_ptr_jump_parallel(lst, threads);
+        std::snprintf(name, sizeof(name), "do_ptr_jump_parallel/%u", threads);
+        t.report(name, n);
+        do_jumped_delete(refs);
+    }
+}
+
+// allocation and traversal rates of heap lists against arena lists
+static void bench_arena(size_t n)
+{
+    {
+        timer t;
+        node* lst = make_list(n);
+        t.report("make_list/heap", n);
+        t.restart();
+        volatile size_t sz = node::size(lst);
+        (void)sz;
+        t.report("node::size/heap", n);
+        delete lst;
+    }
+    {
+        node_arena arena;
+        timer t;
+        node* lst = make_list(n, arena);
+        t.report("make_list/arena", n);
+        t.restart();
+        volatile size_t sz = node::size(lst);
+        (void)sz;
+        t.report("node::size/arena", n);
+        t.restart();
+        arena.release();
+        t.report("node_arena::release", n);
+    }
+}
+
+// pointer jumping on the structure-of-arrays representation
+static void bench_index_list(size_t n)
+{
+    {
+        index_list lst = make_index_list(n);
+        timer t;
+        do_ptr_jump(lst);
+        t.report("do_ptr_jump/index", n);
+    }
+    {
+        index_list lst = make_index_list(n);
+        timer t;
+        do_ptr_jump_parallel(lst, 0);
+        t.report("do_ptr_jump_parallel/index", n);
+    }
+}
+
+static void bench_list_rank(size_t n)
+{
+    node* lst = make_list(n);
+    timer t;
+    auto seq = list_rank(lst);
+    t.report("list_rank", n);
+
+    // ranking while jumping, which a caller jumping anyway pays instead
+    std::vector<node*> refs;
+    std::vector<size_t> rank;
+    t.restart();
+    do_ptr_jump(lst, refs, rank);
+    t.report("do_ptr_jump/with_rank", n);
+    do_jumped_delete(refs);
+}
+
+static void bench_list_scan(size_t n)
+{
+    using ll = long long;
+    node* lst = make_list(n);
+    {
+        // baseline: a plain sequential walk
+        timer t;
+        std::vector<ll> sums;
+        ll acc = 0;
+        for (node* c = lst; c; c = c == c->next ? nullptr : c->next) {
+            acc += c->data;
+            sums.push_back(acc);
+        }
+        t.report("scan_walk_baseline", n);
+    }
+    timer t;
+    auto a = list_scan(lst, std::plus<ll>(), 0LL);
+    t.report("list_scan", n);
+    t.restart();
+    auto b = list_scan_parallel(lst, std::plus<ll>(), 0LL, 0);
+    t.report("list_scan_parallel", n);
+    delete lst;
+
+    index_list soa = make_index_list(n);
+    t.restart();
+    auto c = list_scan_parallel(soa, std::plus<ll>(), 0LL, 0);
+    t.report("list_scan_parallel/index", n);
+}
+
+// appending through the list header
+static void bench_list_header(size_t n)
+{
+    timer t;
+    list lst;
+    for (size_t i = 0; i < n; ++i) {
+        lst.push_back(i);
+    }
+    t.report("list::push_back", n);
+}
+
+// random lookups with node::at against a skip index, and a sorted batch
+static void bench_random_access(size_t n)
+{
+    // node::at costs O(n) per query, so fewer queries on long lists
+    const size_t queries =
+        std::max<size_t>(1, std::min<size_t>(1000, 100'000'000 / n));
+    std::vector<size_t> idx(queries);
+    unsigned long long x = 88172645463325252ull;
+    for (size_t& i : idx) {
+        // xorshift
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        i = x % n;
+    }
+    node* lst = make_list(n);
+    volatile int sink = 0;
+
+    timer t;
+    for (size_t i : idx) {
+        sink = node::at(lst, i)->data;
+    }
+    t.report("node::at/random", n, queries);
+
+    skip_index skip(lst);
+    t.restart();
+    for (size_t i : idx) {
+        sink = skip.at(i)->data;
+    }
+    t.report("skip_index::at/random", n, queries);
+
+    std::sort(idx.begin(), idx.end());
+    t.restart();
+    auto found = node::at_many(lst, idx);
+    sink = found.back()->data;
+    t.report("node::at_many/sorted", n, queries);
+    (void)sink;
+    delete lst;
+}
+
+// steady-state jumping into one reused buffer
+static void bench_reuse(size_t n)
+{
+    std::vector<node*> refs;
+    list lst(n);
+    timer t;
+    do_ptr_jump(lst, refs);
+    t.report("do_ptr_jump/list_reserve", n);
+    do_jumped_delete(refs);
+
+    node* again = make_list(n);
+    t.restart();
+    do_ptr_jump(again, refs);
+    t.report("do_ptr_jump/reused_buffer", n);
+    do_jumped_delete(refs);
+}
+
+// jumping an arena list with and without the refs vector
+static void bench_in_place(size_t n)
+{
+    {
+        node_arena arena;
+        node* lst = make_list(n, arena);
+        timer t;
+        auto refs = do_ptr_jump(lst);
+        t.report("do_ptr_jump/arena", n);
+    }
+    {
+        node_arena arena;
+        node* lst = make_list(n, arena);
+        timer t;
+        do_ptr_jump_in_place(lst);
+        t.report("do_ptr_jump_in_place", n);
+        t.restart();
+        do_jumped_delete(arena, true);
+        t.report("do_jumped_delete/arena_checked", n);
+    }
+    {
+        node_arena arena;
+        do_ptr_jump_in_place(make_list(n, arena));
+        timer t;
+        do_jumped_delete(arena, false);
+        t.report("do_jumped_delete/arena", n);
+    }
+}
+
+// builds and tears down many short lists on every thread, through the node
+// pool and through plain ::operator new for comparison
+static void bench_churn(size_t n)
+{
+    // lists of up to 1000 nodes, n nodes in total per thread
+    const size_t len = std::min<size_t>(n, 1000);
+    const size_t rounds = n / len;
+    const unsigned threads = default_threads();
+
+    timer t;
+    run_threads(threads, [&](unsigned, unsigned, barrier&) {
+        for (size_t r = 0; r < rounds; ++r) {
+            delete make_list(len);
+        }
+    });
+    t.report("churn/pool", n, rounds * len * threads);
+
+    // straight to malloc: the counting operator new above would add two
+    // shared atomic increments per node that the pool never pays
+    auto make_node = [](int data) {
+        void* p = std::malloc(sizeof(node));
+        if (!p) {
+            throw std::bad_alloc();
+        }
+        return ::new (p) node(data);
+    };
+    t.restart();
+    run_threads(threads, [&](unsigned, unsigned, barrier&) {
+        for (size_t r = 0; r < rounds; ++r) {
+            node* root = make_node(0);
+            node* curr = root;
+            for (size_t i = 1; i < len; ++i) {
+                curr->next = make_node(i);
+                curr = curr->next;
+            }
+            for (node* c = root; c;) {
+                node* after = c == c->next ? nullptr : c->next;
+                std::free(c);
+                c = after;
+            }
+        }
+    });
+    t.report("churn/malloc", n, rounds * len * threads);
+}
+
+// traversal bandwidth of an unrolled list against one int per node
+static void bench_unrolled(size_t n)
+{
+    volatile long long sink = 0;
+    null_buf buf;
+    std::ostream out(&buf);
+
+    node* lst = make_list(n);
+    timer t;
+    long long sum = 0;
+    for (node* c = lst; c; c = c == c->next ? nullptr : c->next) {
+        sum += c->data;
+    }
+    sink = sum;
+    t.report("sum/node", n);
+    delete lst;
+
+    t.restart();
+    unrolled_block* ul = make_unrolled_list(n);
+    t.report("make_unrolled_list", n);
+
+    t.restart();
+    sum = 0;
+    for (unrolled_block* b = ul; b; b = b == b->next ? nullptr : b->next) {
+        for (uint32_t i = 0; i < b->count; ++i) {
+            sum += b->data[i];
+        }
+    }
+    sink = sum;
+    t.report("sum/unrolled", n);
+
+    t.restart();
+    sink = unrolled_block::size(ul);
+    t.report("unrolled_block::size", n);
+
+    t.restart();
+    sink = unrolled_block::at(ul, n - 1);
+    t.report("unrolled_block::at/last", n);
+
+    t.restart();
+    out << ul;
+    t.report("operator<</unrolled", n);
+
+    t.restart();
+    auto refs = do_ptr_jump(ul);
+    t.report("do_ptr_jump/unrolled", n);
+    do_jumped_delete(refs);
+    (void)sink;
+}
+
+// a random order of 0..n
+static std::vector<uint32_t> random_order(size_t n, unsigned seed)
+{
+    std::vector<uint32_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(seed));
+    return order;
+}
+
+// `lists` lists of `len` nodes each, with their nodes scattered randomly
+// through one arena so every hop is a cache miss
+static std::vector<node*> make_permuted_lists(size_t lists, size_t len,
+                                              node_arena& arena)
+{
+    const size_t total = lists * len;
+    arena.reserve(total);
+    std::vector<node*> nodes(total);
+    for (size_t i = 0; i < total; ++i) {
+        nodes[i] = arena.make(i);
+    }
+    auto order = random_order(total, 42);
+    std::vector<node*> starts(lists);
+    for (size_t l = 0; l < lists; ++l) {
+        node* prev = nullptr;
+        for (size_t i = 0; i < len; ++i) {
+            node* n = nodes[order[l * len + i]];
+            if (prev) {
+                prev->next = n;
+            }
+            else {
+                starts[l] = n;
+            }
+            prev = n;
+        }
+    }
+    return starts;
+}
+
+// batched and prefetching traversal on randomly permuted lists
+static void bench_prefetch(size_t n)
+{
+    volatile size_t sink = 0;
+    const size_t lists = std::min<size_t>(n, 64);
+    const size_t len = n / lists;
+    node_arena arena;
+    auto starts = make_permuted_lists(lists, len, arena);
+
+    timer t;
+    for (node* s : starts) {
+        sink = node::size(s);
+    }
+    t.report("node::size/permuted", n, lists * len);
+
+    t.restart();
+    auto sizes = size_batch(starts.data(), starts.size());
+    sink = sizes.back();
+    t.report("size_batch/permuted", n, lists * len);
+
+    std::vector<size_t> idx(lists, len - 1);
+    t.restart();
+    for (node* s : starts) {
+        sink = node::at(s, len - 1)->data;
+    }
+    t.report("node::at/permuted", n, lists * len);
+
+    t.restart();
+    auto found = at_batch(starts.data(), idx.data(), starts.size());
+    sink = found.back()->data;
+    t.report("at_batch/permuted", n, lists * len);
+    arena.release();
+
+    // jumping rounds on an index list scattered through its arrays
+    index_list lst = make_permuted_index_list(n, 7);
+    t.restart();
+    do_ptr_jump(lst);
+    t.report("do_ptr_jump/index_permuted", n);
+    (void)sink;
+}
+
+// traversal of a scattered list before and after compacting it
+static void bench_compact(size_t n)
+{
+    volatile size_t sink = 0;
+    node_arena scattered;
+    node* lst = make_permuted_lists(1, n, scattered)[0];
+
+    timer t;
+    sink = node::size(lst);
+    t.report("compact/size_before", n);
+
+    node_arena arena;
+    t.restart();
+    node* packed = compact(lst, arena);
+    t.report("compact", n);
+    scattered.release();
+
+    t.restart();
+    sink = node::size(packed);
+    t.report("node::size/compacted", n);
+    (void)sink;
+}
+
+// vectorized jumping rounds at each supported level, on an in-order and a
+// permuted index list
+static void bench_simd(size_t n)
+{
+    std::vector<simd_level> levels{simd_level::scalar};
+    for (simd_level l : {simd_level::avx2, simd_level::avx512}) {
+        if (l <= detect_simd()) {
+            levels.push_back(l);
+        }
+    }
+    char name[64];
+    for (simd_level l : levels) {
+        index_list lst = make_index_list(n);
+        timer t;
+        do_ptr_jump_simd(lst, l);
+        std::snprintf(name, sizeof(name), "do_ptr_jump_simd/%s",
+                      simd_level_name(l));
+        t.report(name, n);
+
+        lst = make_permuted_index_list(n, 7);
+        t.restart();
+        do_ptr_jump_simd(lst, l);
+        std::snprintf(name, sizeof(name), "do_ptr_jump_simd/%s_permuted",
+                      simd_level_name(l));
+        t.report(name, n);
+    }
+}
+
+// sequential, wyllie and sublist (helman-jaja) ranking of a permuted index
+// list, the parallel ones at 1..hardware concurrency threads
+static void bench_rank_sublists(size_t n)
+{
+    index_list lst = make_permuted_index_list(n, 7);
+
+    timer t;
+    auto seq = list_rank(lst);
+    t.report("list_rank/index_permuted", n);
+
+    char name[64];
+    for (unsigned threads : thread_counts()) {
+        t.restart();
+        auto w = list_rank_parallel(lst, threads);
+        std::snprintf(name, sizeof(name), "list_rank_parallel/%u", threads);
+        t.report(name, n);
+
+        t.restart();
+        auto hj = list_rank_sublists(lst, threads);
+        std::snprintf(name, sizeof(name), "list_rank_sublists/%u", threads);
+        t.report(name, n);
+    }
+}
+
+// a random forest: each node's parent is a node placed before it in a random
+// order, with a few roots, so trees are shallow and parents heavily shared
+static void bench_forest(size_t n)
+{
+    node_arena arena;
+    arena.reserve(n);
+    std::vector<node*> all(n);
+    for (size_t i = 0; i < n; ++i) {
+        all[i] = arena.make(static_cast<int>(i));
+    }
+    auto order = random_order(n, 11);
+    std::vector<size_t> parent(n);
+    std::mt19937 rng(3);
+    for (size_t i = 0; i < n; ++i) {
+        parent[order[i]] = i < 16 ? order[i] : order[rng() % i];
+    }
+
+    char name[64];
+    for (unsigned threads : thread_counts()) {
+        for (size_t i = 0; i < n; ++i) {
+            all[i]->next = all[parent[i]];
+        }
+        timer t;
+        jump_to_roots(all, threads);
+        std::snprintf(name, sizeof(name), "jump_to_roots/%u", threads);
+        t.report(name, n);
+    }
+    arena.release();
+}
+
+// random k-th successor queries: walking costs O(k) per query, the binary
+// lifting table O(log(k)) lookups whatever its level stride
+static void bench_successor(size_t n)
+{
+    index_list lst = make_index_list(n);
+    const size_t queries = 1 << 20;
+    const size_t walks =
+        std::max<size_t>(1, std::min<size_t>(queries, 100'000'000 / n));
+    std::vector<uint32_t> from(queries);
+    std::vector<size_t> hops(queries);
+    std::mt19937_64 rng(5);
+    for (size_t i = 0; i < queries; ++i) {
+        from[i] = static_cast<uint32_t>(rng() % n);
+        hops[i] = rng() % n;
+    }
+    volatile uint32_t sink = 0;
+
+    timer t;
+    for (size_t i = 0; i < walks; ++i) {
+        uint32_t idx = from[i];
+        for (size_t k = hops[i]; k > 0 && lst.next[idx] != idx; --k) {
+            idx = lst.next[idx];
+        }
+        sink = idx;
+    }
+    t.report("successor/walk", n, walks);
+
+    char name[64];
+    for (unsigned stride : {1u, 2u, 4u}) {
+        t.restart();
+        successor_table tbl(lst, stride);
+        std::snprintf(name, sizeof(name), "successor_table/build/%u", stride);
+        t.report(name, n);
+
+        t.restart();
+        for (size_t i = 0; i < queries; ++i) {
+            sink = tbl.successor(from[i], hops[i]);
+        }
+        std::snprintf(name, sizeof(name), "successor_table/query/%u", stride);
+        t.report(name, n, queries);
+    }
+    (void)sink;
+}
+
+// the cost of brent's cycle check on the walks it guards
+static void bench_cycle_check(size_t n)
+{
+    node* lst = make_list(n);
+    volatile size_t sink = 0;
+
+    timer t;
+    sink = node::size(lst, false);
+    t.report("node::size/unchecked", n);
+
+    t.restart();
+    sink = node::size(lst, true);
+    t.report("node::size/checked", n);
+
+    t.restart();
+    sink = find_cycle(lst) == nullptr;
+    t.report("find_cycle", n);
+
+    // a first untimed jump faults the buffer in, then each one is undone
+    std::vector<node*> refs;
+    for (int checked = -1; checked < 2; ++checked) {
+        t.restart();
+        do_ptr_jump(lst, refs, checked == 1);
+        if (checked >= 0) {
+            t.report(checked ? "do_ptr_jump/checked" : "do_ptr_jump/unchecked",
+                     n);
+        }
+        for (size_t i = 0; i + 1 < n; ++i) {
+            refs[i]->next = refs[i + 1];
+        }
+    }
+    do_ptr_jump(lst, refs);
+    (void)sink;
+    do_jumped_delete(refs);
+}
+
+// checking a jumped list: the plain sequential scan against verify_jumped
+static void bench_verify(size_t n)
+{
+    std::vector<node*> refs = do_ptr_jump(make_list(n));
+    volatile size_t sink = 0;
+
+    timer t;
+    const node* terminal = refs[0]->next;
+    size_t bad = n;
+    for (size_t i = 0; i < n; ++i) {
+        if (refs[i]->next != terminal) {
+            bad = i;
+            break;
+        }
+    }
+    sink = bad;
+    t.report("verify/sequential", n);
+
+    char name[64];
+    for (simd_level level :
+         {simd_level::scalar, simd_level::avx2, simd_level::avx512}) {
+        if (level > detect_simd()) {
+            continue;
+        }
+        for (unsigned threads : thread_counts()) {
+            t.restart();
+            sink = verify_jumped(refs, threads, level);
+            std::snprintf(name, sizeof(name), "verify_jumped/%s/%u",
+                          simd_level_name(level), threads);
+            t.report(name, n);
+        }
+    }
+    (void)sink;
+    do_jumped_delete(refs);
+}
+
+// streambuf that counts and throws away what is written to it
+class count_buf : public std::streambuf {
+public:
+    size_t bytes = 0;
+
+protected:
+    int overflow(int c) override
+    {
+        ++bytes;
+        return traits_type::not_eof(c);
+    }
+    std::streamsize xsputn(const char*, std::streamsize n) override
+    {
+        bytes += n;
+        return n;
+    }
+};
+
+// printing a list: one formatted insertion per element against operator<<'s
+// to_chars path. items are output bytes, so MB/s is 1000 / ns_per_item.
+static void bench_format(size_t n)
+{
+    node* lst = make_list(n);
+
+    count_buf slow_buf;
+    std::ostream slow(&slow_buf);
+    timer t;
+    slow << '{';
+    for (const node* p = lst; p; p = p == p->next ? nullptr : p->next) {
+        slow << p->data << (p == p->next ? "" : ", ");
+    }
+    slow << '}';
+    t.report("format/insertion", n, slow_buf.bytes);
+
+    count_buf fast_buf;
+    std::ostream fast(&fast_buf);
+    t.restart();
+    fast << lst;
+    t.report("format/operator<<", n, fast_buf.bytes);
+    delete lst;
+}
+
+struct bench_group {
+    const char* name;
+    void (*fn)(size_t);
+};
+
+static const bench_group groups[] = {
+    {"core", bench_core},
+    {"rec_jump", bench_rec_jump},
+    {"parallel", bench_ptr_jump_parallel},
+    {"arena", bench_arena},
+    {"index_list", bench_index_list},
+    {"list_rank", bench_list_rank},
+    {"list_scan", bench_list_scan},
+    {"list", bench_list_header},
+    {"random_access", bench_random_access},
+    {"in_place", bench_in_place},
+    {"reuse", bench_reuse},
+    {"churn", bench_churn},
+    {"unrolled", bench_unrolled},
+    {"prefetch", bench_prefetch},
+    {"compact", bench_compact},
+    {"simd", bench_simd},
+    {"rank_sublists", bench_rank_sublists},
+    {"forest", bench_forest},
+    {"successor", bench_successor},
+    {"cycle_check", bench_cycle_check},
+    {"verify", bench_verify},
+    {"format", bench_format},
+};
+
+// usage: lab3bench.out [list sizes...] [group names...]
+//
+// writes one csv row per measurement to stdout. with no sizes, runs every
+// power of ten from 10 to 10^8; with no group names, runs every group.
+int main(int argc, char** argv)
+{
+    std::vector<size_t> sizes;
+    std::vector<std::string> only;
+    for (int i = 1; i < argc; ++i) {
+        char* end;
+        size_t n = std::strtoull(argv[i], &end, 10);
+        if (*end == '\0' && n > 0) {
+            sizes.push_back(n);
+        }
+        else {
+            only.push_back(argv[i]);
+        }
+    }
+    if (sizes.empty()) {
+        for (size_t n = 10; n <= 100'000'000; n *= 10) {
+            sizes.push_back(n);
+        }
+    }
+
+    print_header();
+    for (size_t n : sizes) {
+        for (const bench_group& g : groups) {
+            if (only.empty() ||
+                std::find(only.begin(), only.end(), g.name) != only.end()) {
+                g.fn(n);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,100 @@
+#include "compact.hpp"
+#include "list_rank.hpp"
+#include "parallel.hpp"
+
+// a node chain is ranked by walking it: the walk visits nodes in list order,
+// so each is simply placed after the previous one.
+node* compact(const node* start, node_arena& arena)
+{
+    if (!start) {
+        return nullptr;
+    }
+    size_t len = 1;
+    for (const node* n = start; n != n->next; n = n->next) {
+        ++len;
+    }
+    arena.reserve(len);
+    node* root = arena.make(start->data);
+    node* curr = root;
+    while (start != start->next) {
+        start = start->next;
+        curr->next = arena.make(start->data);
+        curr = curr->next;
+    }
+    return root;
+}
+
+index_list compact(const index_list& lst, unsigned threads)
+{
+    const size_t n = lst.next.size();
+    std::vector<uint32_t> rank = threads == 1
+                                     ? list_rank(lst)
+                                     : list_rank_parallel(lst, threads);
+    index_list out;
+    out.data.resize(n);
+    out.next.resize(n);
+    out.head = 0;
+    run_threads(threads, [&](unsigned tid, unsigned nthreads, barrier&) {
+        auto [lo, hi] = block_range(n, tid, nthreads);
+        for (size_t i = lo; i < hi; ++i) {
+            uint32_t pos = n - 1 - rank[i];
+            out.data[pos] = lst.data[i];
+            out.next[pos] = pos + 1 < n ? pos + 1 : pos;
+        }
+    });
+    return out;
+}
+
+#ifdef TESTING
+#include "doctest.h"
+#include <sstream>
+
+TEST_CASE("compact")
+{
+    SUBCASE("node")
+    {
+        node_arena arena;
+        CHECK(compact(nullptr, arena) == nullptr);
+
+        // a list whose nodes are out of address order
+        node* foo = make_list({4, 3, 2, 1, 0});
+        auto n = node::at_many(foo, {0, 1, 2, 3, 4});
+        n[0]->next = n[3];
+        n[3]->next = n[1];
+        n[1]->next = n[4];
+        n[2]->next = n[2];
+        node* dropped = n[2];
+        // foo is now 4 -> 1 -> 3 -> 0
+
+        node* bar = compact(foo, arena);
+        CHECK(node::size(bar) == 4);
+        for (size_t i = 0; i < 4; ++i) {
+            CHECK(node::at(bar, i) == bar + i);
+            CHECK(node::at(bar, i)->data == node::at(foo, i)->data);
+        }
+        delete foo;
+        delete dropped;
+    }
+    SUBCASE("index_list")
+    {
+        // list order 3 -> 1 -> 4 -> 0 -> 2
+        index_list lst;
+        lst.data = {10, 11, 12, 13, 14};
+        lst.next = {2, 4, 2, 1, 0};
+        lst.head = 3;
+        for (unsigned threads : {1u, 3u}) {
+            CAPTURE(threads);
+            index_list out = compact(lst, threads);
+            CHECK(out.head == 0);
+            CHECK(out.data == std::vector<int32_t>{13, 11, 14, 10, 12});
+            CHECK(out.next == std::vector<uint32_t>{1, 2, 3, 4, 4});
+            std::ostringstream a, b;
+            a << lst;
+            b << out;
+            CHECK(a.str() == b.str());
+        }
+        CHECK(compact(index_list()).empty());
+    }
+}
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef COMPACT_HPP
+#define COMPACT_HPP
+
+#include "arena.hpp"
+#include "index_list.hpp"
+#include "linked_list.hpp"
+
+// relayout passes: copy a list so its elements sit contiguously in list order
+// and traversal streams through memory instead of chasing scattered nodes.
+
+// copies the list beginning at `start` into `arena`, node i of the list at the
+// i-th slot of one contiguous block, and returns the new head. the original
+// list is left alone for the caller to free.
+node* compact(const node* start, node_arena& arena);
+
+// renumbers the elements of `lst` so that element i is the i-th in list order
+// (`head == 0`, `next[i] == i + 1`). positions come from list ranking with
+// `threads` workers, and the elements are moved in parallel.
+// `threads == 0` uses the hardware concurrency.
+index_list compact(const index_list& lst, unsigned threads = 1);
+
+#endif
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "forest.hpp"
+#include "index_list.hpp"
+#include "parallel.hpp"
+
+void jump_to_roots(std::vector<node*>& all, unsigned threads, bool checked)
+{
+    const size_t n = all.size();
+    if (n == 0) {
+        return;
+    }
+    if (threads == 0) {
+        threads = default_threads();
+    }
+
+    if (checked) {
+        std::vector<node*> sorted(all);
+        std::sort(sorted.begin(), sorted.end());
+        for (node* p : all) {
+            if (!std::binary_search(sorted.begin(), sorted.end(), p->next)) {
+                throw std::invalid_argument("parent not in forest");
+            }
+        }
+    }
+
+    // each round reads every parent's parent into `jumped` and only then
+    // writes them back, so shared parents are read consistently
+    std::vector<node*> jumped(n);
+    std::vector<char> changed(threads);
+    // no node is more than n - 1 hops from its root, so a forest converges
+    // within this many rounds; a cycle never does
+    const size_t max_rounds = jump_rounds(n) + 1;
+    bool converged = false;
+
+    run_threads(threads, [&](unsigned tid, unsigned nthreads, barrier& sync) {
+        auto [lo, hi] = block_range(n, tid, nthreads);
+        for (size_t r = 0; r < max_rounds; ++r) {
+            bool any = false;
+            for (size_t i = lo; i < hi; ++i) {
+                node* parent = all[i]->next;
+                jumped[i] = parent->next;
+                any |= jumped[i] != parent;
+            }
+            changed[tid] = any;
+            sync.wait();
+            for (size_t i = lo; i < hi; ++i) {
+                all[i]->next = jumped[i];
+            }
+            // every thread reaches the same decision
+            bool done = std::none_of(changed.begin(), changed.end(),
+                                     [](char c) { return c; });
+            // nobody reads a parent or overwrites `changed` until everyone
+            // has written back and read it
+            sync.wait();
+            if (done) {
+                if (tid == 0) {
+                    converged = true;
+                }
+                break;
+            }
+        }
+    });
+
+    if (!converged) {
+        throw std::domain_error("cycle in forest");
+    }
+}
+
+#ifdef TESTING
+#include "doctest.h"
+
+// deletes forest nodes that all point to roots
+static void delete_forest(std::vector<node*>& all)
+{
+    for (node* n : all) {
+        n->next = n;
+        delete n;
+    }
+}
+
+TEST_CASE("jump_to_roots")
+{
+    SUBCASE("empty")
+    {
+        std::vector<node*> all;
+        jump_to_roots(all);
+        CHECK(all.empty());
+    }
+    SUBCASE("two trees with shared parents")
+    {
+        //      0          5
+        //     / \         |
+        //    1   2        6
+        //   / \   \       |
+        //  3   4   7      8
+        std::vector<node*> all;
+        for (int i = 0; i < 9; ++i) {
+            all.push_back(new node(i));
+        }
+        int parent[] = {0, 0, 0, 1, 1, 5, 5, 2, 6};
+        for (int i = 0; i < 9; ++i) {
+            all[i]->next = all[parent[i]];
+        }
+        // the order of `all` doesn't matter
+        std::swap(all[0], all[7]);
+        std::swap(all[3], all[5]);
+        for (unsigned threads : {1u, 2u, 4u}) {
+            CAPTURE(threads);
+            jump_to_roots(all, threads);
+            for (node* n : all) {
+                int root = n->data == 5 || n->data == 6 || n->data == 8 ? 5 : 0;
+                CHECK(n->next->data == root);
+                CHECK(n->next->next == n->next);
+            }
+        }
+        delete_forest(all);
+    }
+    SUBCASE("a long list is one tree")
+    {
+        node* foo = make_list(1000);
+        std::vector<node*> all = do_ptr_jump(foo);
+        // undo the jumping so the chain is rebuilt, then jump as a forest
+        for (size_t i = 0; i + 1 < all.size(); ++i) {
+            all[i]->next = all[i + 1];
+        }
+        jump_to_roots(all, 3);
+        for (node* n : all) {
+            CHECK(n->next == all.back());
+        }
+        do_jumped_delete(all);
+    }
+    SUBCASE("cycle")
+    {
+        // 0 -> 1 -> 2 -> 0, with 3 hanging off it
+        std::vector<node*> all;
+        for (int i = 0; i < 4; ++i) {
+            all.push_back(new node(i));
+        }
+        all[0]->next = all[1];
+        all[1]->next = all[2];
+        all[2]->next = all[0];
+        all[3]->next = all[0];
+        for (unsigned threads : {1u, 2u}) {
+            CAPTURE(threads);
+            CHECK_THROWS_AS(jump_to_roots(all, threads, true),
+                            std::domain_error);
+        }
+        delete_forest(all);
+    }
+    SUBCASE("parent outside the forest")
+    {
+        node* outside = new node(0);
+        node* a = new node(1);
+        a->next = outside;
+        std::vector<node*> all{a};
+        CHECK_THROWS_AS(jump_to_roots(all, 2, true), std::invalid_argument);
+        CHECK(a->next == outside);
+        a->next = a;
+        delete a;
+        delete outside;
+    }
+}
+
+#endif
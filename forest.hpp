@@ -0,0 +1,30 @@
+#ifndef FOREST_HPP
+#define FOREST_HPP
+
+#include <vector>
+
+#include "linked_list.hpp"
+
+// pointer jumping over a forest of in-trees.
+//
+// `all` holds every node of the forest; each node's `next` is its parent,
+// and roots point to themselves like the terminal of a list. many nodes may
+// share a parent. afterwards every node points directly at its root.
+//
+// runs synchronous wyllie rounds across `threads` worker threads, reading
+// every parent's parent before any is written back so shared parents are read
+// consistently, and stops after the first round that changes nothing.
+// `threads == 0` uses the hardware concurrency.
+//
+// every parent must be in `all`. when `checked`, that is verified first and
+// `std::invalid_argument` is thrown (changing nothing) if one isn't; the check
+// sorts the nodes, so it costs far more than the jumping.
+//
+// a forest converges within `jump_rounds(n) + 1` rounds. parents that form a
+// cycle never do, so after that many rounds `std::domain_error` is thrown,
+// leaving the nodes partly jumped. (a cycle whose length is a power of two
+// collapses into self-loops, which look like roots.)
+void jump_to_roots(std::vector<node*>& all, unsigned threads = 0,
+                   bool checked = traversal_checked);
+
+#endif
@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+#include "index_list.hpp"
+#include "parallel.hpp"
+
+uint32_t index_list::index_of(size_t idx) const
+{
+    if (empty()) {
+        throw std::out_of_range("empty list");
+    }
+    uint32_t tgt = head;
+    for (size_t i = 0; i < idx; ++i) {
+        // bounds check
+        if (tgt == next[tgt]) {
+            throw std::out_of_range("index >= size");
+        }
+        tgt = next[tgt];
+    }
+    return tgt;
+}
+
+int32_t& index_list::at(size_t idx) { return data[index_of(idx)]; }
+
+const int32_t& index_list::at(size_t idx) const
+{
+    return data[index_of(idx)];
+}
+
+size_t index_list::size() const
+{
+    if (empty()) {
+        return 0;
+    }
+    uint32_t curr = head;
+    size_t sz = 1;
+    while (next[curr] != curr) {
+        ++sz;
+        curr = next[curr];
+    }
+    return sz;
+}
+
+index_list index_list::from_nodes(const node* start)
+{
+    index_list lst;
+    while (start) {
+        if (lst.data.size() == std::numeric_limits<uint32_t>::max()) {
+            throw std::length_error("list too long for 32-bit indices");
+        }
+        uint32_t i = lst.data.size();
+        lst.data.push_back(start->data);
+        if (start == start->next) {
+            lst.next.push_back(i);
+            break;
+        }
+        lst.next.push_back(i + 1);
+        start = start->next;
+    }
+    return lst;
+}
+
+node* index_list::to_nodes() const
+{
+    if (empty()) {
+        return nullptr;
+    }
+    uint32_t i = head;
+    node* root = new node(data[i]);
+    node* curr = root;
+    while (i != next[i]) {
+        i = next[i];
+        curr->next = new node(data[i]);
+        curr = curr->next;
+    }
+    return root;
+}
+
+std::ostream& operator<<(std::ostream& os, const index_list& lst)
+{
+    os << '{';
+    if (!lst.empty()) {
+        uint32_t i = lst.head;
+        while (i != lst.next[i]) {
+            os << lst.data[i] << ", ";
+            i = lst.next[i];
+        }
+        os << lst.data[i];
+    }
+    return os << '}';
+}
+
+index_list make_index_list(size_t nelts)
+{
+    if (nelts > std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("list too long for 32-bit indices");
+    }
+    index_list lst;
+    lst.data.resize(nelts);
+    lst.next.resize(nelts);
+    for (size_t i = 0; i < nelts; ++i) {
+        lst.data[i] = i;
+        lst.next[i] = i + 1 < nelts ? i + 1 : i;
+    }
+    return lst;
+}
+
+index_list make_index_list(std::initializer_list<int> init)
+{
+    index_list lst = make_index_list(init.size());
+    std::copy(init.begin(), init.end(), lst.data.begin());
+    return lst;
+}
+
+index_list make_permuted_index_list(size_t nelts, unsigned seed)
+{
+    index_list lst = make_index_list(nelts);
+    if (nelts == 0) {
+        return lst;
+    }
+    std::vector<uint32_t> order(nelts);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(seed));
+    for (size_t i = 0; i + 1 < nelts; ++i) {
+        lst.next[order[i]] = order[i + 1];
+    }
+    lst.next[order[nelts - 1]] = order[nelts - 1];
+    lst.head = order[0];
+    return lst;
+}
+
+size_t jump_rounds(size_t n)
+{
+    size_t rounds = 0;
+    while ((size_t(1) << rounds) < n) {
+        ++rounds;
+    }
+    return rounds;
+}
+
+// how many elements ahead a jumping round prefetches its gather target
+static const size_t prefetch_distance = 16;
+
+// one jumping round over [lo, hi): out[i] = in[in[i]].
+//
+// there is no loop-carried dependency, so this is a plain gather. in[i] for a
+// later i is already known, so its target is prefetched ahead of use; this
+// matters when the list is scattered through the array and every gather is a
+// cache miss.
+static void jump_round(const uint32_t* in, uint32_t* out, size_t lo, size_t hi)
+{
+    size_t i = lo;
+    for (; i + prefetch_distance < hi; ++i) {
+        __builtin_prefetch(in + in[i + prefetch_distance]);
+        out[i] = in[in[i]];
+    }
+    for (; i < hi; ++i) {
+        out[i] = in[in[i]];
+    }
+}
+
+void do_ptr_jump(index_list& lst)
+{
+    const size_t n = lst.next.size();
+    const size_t rounds = jump_rounds(n);
+    std::vector<uint32_t> buf(n);
+    uint32_t* in = lst.next.data();
+    uint32_t* out = buf.data();
+    for (size_t r = 0; r < rounds; ++r) {
+        jump_round(in, out, 0, n);
+        std::swap(in, out);
+    }
+    if (in == buf.data()) {
+        lst.next.swap(buf);
+    }
+}
+
+void do_ptr_jump_parallel(index_list& lst, unsigned threads)
+{
+    const size_t n = lst.next.size();
+    const size_t rounds = jump_rounds(n);
+    std::vector<uint32_t> buf(n);
+    run_threads(threads, [&](unsigned tid, unsigned nthreads, barrier& sync) {
+        auto [lo, hi] = block_range(n, tid, nthreads);
+        uint32_t* in = lst.next.data();
+        uint32_t* out = buf.data();
+        for (size_t r = 0; r < rounds; ++r) {
+            jump_round(in, out, lo, hi);
+            std::swap(in, out);
+            // the next round reads what every thread just wrote
+            sync.wait();
+        }
+    });
+    if (rounds % 2 == 1) {
+        lst.next.swap(buf);
+    }
+}
+
+#ifdef TESTING
+#include "doctest.h"
+#include <sstream>
+
+TEST_CASE("index_list")
+{
+    SUBCASE("make_index_list(size_t)")
+    {
+        index_list empty = make_index_list(0);
+        CHECK(empty.size() == 0);
+        CHECK_THROWS(empty.at(0));
+
+        index_list foo = make_index_list(5);
+        CHECK(foo.size() == 5);
+        for (size_t i = 0; i < 5; ++i) {
+            CHECK(foo.at(i) == int(i));
+        }
+        CHECK_THROWS(foo.at(5));
+    }
+    SUBCASE("make_permuted_index_list")
+    {
+        CHECK(make_permuted_index_list(0, 1).size() == 0);
+        for (size_t len : {1, 2, 100}) {
+            CAPTURE(len);
+            index_list foo = make_permuted_index_list(len, 3);
+            // every element is on the chain exactly once
+            CHECK(foo.size() == len);
+            std::vector<int> seen;
+            for (size_t i = 0; i < len; ++i) {
+                seen.push_back(foo.at(i));
+            }
+            std::sort(seen.begin(), seen.end());
+            for (size_t i = 0; i < len; ++i) {
+                CHECK(seen[i] == int(i));
+            }
+        }
+    }
+    SUBCASE("make_index_list(initializer_list<int>)")
+    {
+        index_list empty = make_index_list({});
+        CHECK(empty.size() == 0);
+
+        index_list foo = make_index_list({-100, 14, 2, 0, 0xbeef});
+        CHECK(foo.size() == 5);
+        CHECK(foo.at(0) == -100);
+        CHECK(foo.at(1) == 14);
+        CHECK(foo.at(4) == 0xbeef);
+        CHECK_THROWS(foo.at(5));
+    }
+    SUBCASE("operator<<")
+    {
+        std::ostringstream out;
+        out << make_index_list(0) << make_index_list(1)
+            << make_index_list(5);
+        CHECK(out.str() == "{}{0}{0, 1, 2, 3, 4}");
+    }
+    SUBCASE("non-contiguous-order")
+    {
+        // list order 2 -> 0 -> 1
+        index_list foo;
+        foo.data = {10, 11, 12};
+        foo.next = {1, 1, 0};
+        foo.head = 2;
+        std::ostringstream out;
+        out << foo;
+        CHECK(out.str() == "{12, 10, 11}");
+        CHECK(foo.size() == 3);
+        CHECK(foo.at(2) == 11);
+    }
+    SUBCASE("node conversion")
+    {
+        CHECK(index_list::from_nodes(nullptr).empty());
+        CHECK(index_list().to_nodes() == nullptr);
+
+        node* foo = make_list({4, 3, 2, 1, 0});
+        index_list lst = index_list::from_nodes(foo);
+        std::ostringstream a, b;
+        a << foo;
+        b << lst;
+        CHECK(a.str() == b.str());
+
+        node* bar = lst.to_nodes();
+        std::ostringstream c;
+        c << bar;
+        CHECK(a.str() == c.str());
+        delete foo;
+        delete bar;
+    }
+    SUBCASE("do_ptr_jump")
+    {
+        for (size_t len : {0, 1, 2, 5, 1000, 1025}) {
+            CAPTURE(len);
+            index_list seq = make_index_list(len);
+            index_list par = make_index_list(len);
+            do_ptr_jump(seq);
+            do_ptr_jump_parallel(par, 3);
+            for (size_t i = 0; i < len; ++i) {
+                CHECK(seq.next[i] == len - 1);
+                CHECK(par.next[i] == len - 1);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef INDEX_LIST_HPP
+#define INDEX_LIST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <ostream>
+#include <vector>
+
+#include "linked_list.hpp"
+
+// structure-of-arrays linked list.
+//
+// element `i` holds `data[i]` and its successor is `next[i]`, a 32-bit index.
+// like `node`, the terminal element points to itself. this halves the memory
+// per element compared to `node` and keeps the successors in one flat array so
+// pointer jumping rounds vectorize.
+struct index_list {
+    std::vector<int32_t> data;
+    std::vector<uint32_t> next;
+    // index of the first element, meaningless when empty
+    uint32_t head = 0;
+
+    bool empty() const { return data.empty(); }
+
+    // bounds-checked element access, walking from `head` like `node::at`
+    int32_t& at(size_t idx);
+    const int32_t& at(size_t idx) const;
+
+    // number of elements in the chain from `head` to the terminal, like
+    // `node::size`
+    size_t size() const;
+
+    // copies the list beginning at `start`, numbering elements in list order
+    static index_list from_nodes(const node* start);
+
+    // copies the chain from `head` into newly allocated nodes
+    node* to_nodes() const;
+
+    friend std::ostream& operator<<(std::ostream&, const index_list&);
+
+private:
+    uint32_t index_of(size_t idx) const;
+};
+
+// create an index list with data elements 0..nelts
+index_list make_index_list(size_t nelts);
+// create an index list with the given data elements
+index_list make_index_list(std::initializer_list<int> lst);
+// create an index list with data elements 0..nelts whose list order is a
+// random permutation (seeded by `seed`) of the storage order, so every hop
+// lands somewhere unrelated to the last
+index_list make_permuted_index_list(size_t nelts, unsigned seed);
+
+// the number of jumping rounds after which every element of a list of `n`
+// elements points to the terminal: ceil(log2(n)).
+size_t jump_rounds(size_t n);
+
+// redirects every element to the terminal using wyllie pointer jumping rounds
+// (`next[i] = next[next[i]]`) over the successor array.
+void do_ptr_jump(index_list& lst);
+
+// the same, with each round split across `threads` worker threads.
+// `threads == 0` uses the hardware concurrency.
+void do_ptr_jump_parallel(index_list& lst, unsigned threads);
+
+#endif
@@ -1,4 +1,4 @@
-#ifndef TESTING
+#if !defined(TESTING) && !defined(BENCHMARK)
 
 #include "linked_list.hpp"
 #include <iostream>
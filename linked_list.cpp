@@ -1,151 +1,87 @@
 #include <stdexcept>
 #include <vector>
 
+#include "arena.hpp"
 #include "linked_list.hpp"
 
-node* make_list(size_t nelts)
+node* make_list(size_t nelts, node_arena& arena)
 {
     if (nelts < 1) {
         return nullptr;
     }
-    node* root = new node(0);
+    arena.reserve(nelts);
+    node* root = arena.make(0);
     node* curr = root;
     for (size_t i = 1; i < nelts; ++i) {
-        curr->next = new node(i);
+        curr->next = arena.make(i);
         curr = curr->next;
     }
     return root;
 }
 
-node* make_list(std::initializer_list<int> lst)
+node* make_list(std::initializer_list<int> lst, node_arena& arena)
 {
     if (lst.size() == 0) {
         return nullptr;
     }
+    arena.reserve(lst.size());
     const int* d = lst.begin();
-    node* root = new node(*d++);
+    node* root = arena.make(*d++);
     node* curr = root;
     while (d != lst.end()) {
-        curr->next = new node(*d++);
+        curr->next = arena.make(*d++);
         curr = curr->next;
     }
     return root;
 }
 
-node* node::at(node* start, size_t idx)
+void do_jumped_delete(node_arena& arena, bool checked)
 {
-    if (!start) {
-        throw std::out_of_range("empty list");
-    }
-    node* tgt = start;
-    for (size_t i = 0; i < idx; ++i) {
-        // bounds check
-        if (tgt == tgt->next) {
-            throw std::out_of_range("index >= size");
-        }
-        tgt = tgt->next;
-    }
-    return tgt;
-}
-
-size_t node::size(node* start)
-{
-    if (!start) {
-        return 0;
-    }
-    node* curr = start;
-    size_t sz = 1;
-
-    while (curr->next != curr) {
-        ++sz;
-        curr = curr->next;
-    }
-    return sz;
-}
-
-std::ostream& operator<<(std::ostream& os, const node* n)
-{
-    os << '{';
-    while (n && n != n->next) {
-        os << n->data << ", ";
-        n = n->next;
-    }
-    if (n) {
-        os << n->data;
-    }
-    return os << '}';
-}
-
-// performs the recursive step in `do_ptr_jump`
-//
-// stores a pointer to each visited node in `refs` so the nodes left dangling
-// after jumping can be deleted.
-static node* rec_jump(node* n, std::vector<node*>& refs)
-{
-    refs.push_back(n);
-    if (n == n->next) {
-        // we've hit the end
-        return n;
-    }
-    else {
-        // recurse
-        n->next = rec_jump(n->next, refs);
-        return n->next;
+    if (checked) {
+        // the arena may hold several lists, each with its own terminal
+        arena.for_each([](node* n) {
+            if (n->next != n->next->next) {
+                throw std::domain_error("deleting non-jumped list");
+            }
+        });
     }
+    arena.release();
 }
 
-// performs the pointer jumping algorithm recursively.
-std::vector<node*> do_ptr_jump(node* start)
-{
-    // save references to the nodes that will dangle after jumping
-    std::vector<node*> refs;
-    if (!start) {
-        return refs;
-    }
-
-    rec_jump(start, refs);
+#ifdef TESTING
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "doctest.h"
+#include "list_rank.hpp"
+#include "verify.hpp"
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <limits>
+#include <new>
+#include <sstream>
+#include <string>
 
-    return refs;
-}
+// counts every heap allocation in the test binary, for tests that check a
+// code path doesn't allocate.
+std::atomic<size_t> test_alloc_count{0};
 
-// given the list of nodes all pointing to the terminal node, correctly delete
-// all the nodes.
-//
-// tested with valgrind
-void do_jumped_delete(std::vector<node*>& lst)
+void* operator new(size_t sz)
 {
-    if (lst.size() == 0) {
-        return;
-    }
-    node* terminal = lst[0]->next;
-    for (node* n : lst) {
-        if (n->next != terminal) {
-            throw std::domain_error("deleting non-jumped list");
-        }
-        // ensure terminal is only deleted once.
-        n->next = n;
-        delete n;
+    test_alloc_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(sz ? sz : 1)) {
+        return p;
     }
+    throw std::bad_alloc();
 }
 
-#ifdef TESTING
-#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
-#include "doctest.h"
-#include <sstream>
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
 
 // simply checks that all the nodes in a list point to a terminal node.
 static bool verify_ptr_jump(std::vector<node*>& lst)
 {
-    if (lst.size() == 0) {
-        return true;
-    }
-    node* terminal = lst[0]->next;
-    for (node* n : lst) {
-        if (n->next != terminal) {
-            return false;
-        }
-    }
-    return true;
+    return verify_jumped(lst) == lst.size();
 }
 
 TEST_CASE("verify_ptr_jump")
@@ -195,6 +131,335 @@ TEST_CASE("do_ptr_jumping")
         CHECK(verify_ptr_jump(refs));
         do_jumped_delete(refs);
     }
+    SUBCASE("refs-in-list-order")
+    {
+        node* foo = make_list({4, 3, 2, 1, 0});
+        auto refs = do_ptr_jump(foo);
+        REQUIRE(refs.size() == 5);
+        for (size_t i = 0; i < refs.size(); ++i) {
+            CHECK(refs[i]->data == 4 - int(i));
+        }
+        CHECK(refs.back()->next == refs.back());
+        do_jumped_delete(refs);
+    }
+    SUBCASE("million-element")
+    {
+        // would overflow the stack with a recursive implementation
+        node* foo = make_list(1'000'000);
+        auto refs = do_ptr_jump(foo);
+        CHECK(refs.size() == 1'000'000);
+        CHECK(verify_ptr_jump(refs));
+        do_jumped_delete(refs);
+    }
+}
+
+TEST_CASE("do_ptr_jump reusing a buffer")
+{
+    std::vector<node*> refs;
+    node* foo = make_list(1000);
+    do_ptr_jump(foo, refs);
+    CHECK(refs.size() == 1000);
+    CHECK(verify_ptr_jump(refs));
+    do_jumped_delete(refs);
+
+    // steady state: the buffer is big enough so jumping doesn't allocate
+    for (size_t len : {1000, 10, 0, 999}) {
+        CAPTURE(len);
+        node* bar = make_list(len);
+        size_t before = test_alloc_count.load();
+        do_ptr_jump(bar, refs);
+        CHECK(test_alloc_count.load() == before);
+        CHECK(refs.size() == len);
+        CHECK(verify_ptr_jump(refs));
+        do_jumped_delete(refs);
+    }
+}
+
+TEST_CASE("do_ptr_jump with ranks")
+{
+    std::vector<node*> refs;
+    std::vector<size_t> rank;
+    do_ptr_jump<int>(nullptr, refs, rank);
+    CHECK(refs.empty());
+    CHECK(rank.empty());
+    for (size_t len : {1, 2, 5, 1000}) {
+        CAPTURE(len);
+        node* foo = make_list(len);
+        std::vector<size_t> expect = list_rank(foo);
+        do_ptr_jump(foo, refs, rank);
+        CHECK(verify_ptr_jump(refs));
+        CHECK(rank == expect);
+        do_jumped_delete(refs);
+    }
+}
+
+TEST_CASE("do_ptr_jump_in_place")
+{
+    CHECK(do_ptr_jump_in_place<int>(nullptr) == nullptr);
+    for (size_t len : {1, 2, 5, 1000}) {
+        CAPTURE(len);
+        node_arena arena;
+        node* foo = make_list(len, arena);
+        node* terminal = do_ptr_jump_in_place(foo);
+        CHECK(terminal == foo + (len - 1));
+        CHECK(terminal->next == terminal);
+        // arena lists are contiguous so every node can still be checked
+        for (size_t i = 0; i < len; ++i) {
+            CHECK(foo[i].next == terminal);
+            CHECK(foo[i].data == int(i));
+        }
+        do_jumped_delete(arena);
+        CHECK(arena.size() == 0);
+    }
+}
+
+TEST_CASE("do_jumped_delete(node_arena&)")
+{
+    SUBCASE("several lists")
+    {
+        node_arena arena;
+        do_ptr_jump_in_place(make_list(5, arena));
+        do_ptr_jump_in_place(make_list({1, 2, 3}, arena));
+        CHECK_NOTHROW(do_jumped_delete(arena, true));
+        CHECK(arena.size() == 0);
+    }
+    SUBCASE("non-jumped")
+    {
+        node_arena arena;
+        node* foo = make_list(5, arena);
+        CHECK_THROWS_AS(do_jumped_delete(arena, true), std::domain_error);
+        // nothing was freed
+        CHECK(arena.size() == 5);
+        do_ptr_jump_in_place(foo);
+        CHECK_NOTHROW(do_jumped_delete(arena));
+    }
+    SUBCASE("unchecked")
+    {
+        node_arena arena;
+        make_list(5, arena);
+        do_jumped_delete(arena, false);
+        CHECK(arena.size() == 0);
+    }
+}
+
+TEST_CASE("do_ptr_jump_parallel")
+{
+    for (unsigned threads : {1u, 2u, 3u, 8u}) {
+        CAPTURE(threads);
+        for (size_t len : {0, 1, 2, 5, 1000, 1025}) {
+            CAPTURE(len);
+            node* foo = make_list(len);
+            auto refs = do_ptr_jump_parallel(foo, threads);
+            REQUIRE(refs.size() == len);
+            CHECK(verify_ptr_jump(refs));
+            for (size_t i = 0; i < len; ++i) {
+                CHECK(refs[i]->data == int(i));
+            }
+            if (len > 0) {
+                CHECK(refs.back()->next == refs.back());
+            }
+            do_jumped_delete(refs);
+        }
+    }
+}
+
+TEST_CASE("cycle detection")
+{
+    SUBCASE("well-formed lists")
+    {
+        CHECK(find_cycle<int>(nullptr) == nullptr);
+        for (size_t len : {1, 2, 3, 100}) {
+            node* foo = make_list(len);
+            CHECK(find_cycle(foo) == nullptr);
+            delete foo;
+        }
+    }
+    SUBCASE("lists running into a cycle")
+    {
+        for (size_t tail : {0, 1, 5}) {
+            CAPTURE(tail);
+            for (size_t cyc : {2, 3, 17}) {
+                CAPTURE(cyc);
+                node* foo = make_list(tail + cyc);
+                node* entry = node::at(foo, tail);
+                node* last = node::at(foo, tail + cyc - 1);
+                last->next = entry;
+
+                CHECK(find_cycle(foo) == entry);
+                CHECK_THROWS_AS(node::size(foo, true), std::domain_error);
+                CHECK_THROWS_AS(node::at(foo, 1000, true), std::domain_error);
+                CHECK(node::at(foo, tail + cyc, false) == entry);
+                CHECK_THROWS_AS(node::at_many(foo, {1, 1000}, true),
+                                std::domain_error);
+                std::ostringstream os;
+                CHECK_THROWS_AS(os << foo, std::domain_error);
+
+                // the jumps throw before changing anything
+                CHECK_THROWS_AS(do_ptr_jump(foo, true), std::domain_error);
+                CHECK_THROWS_AS(do_ptr_jump_parallel(foo, 2, true),
+                                std::domain_error);
+                CHECK_THROWS_AS(do_ptr_jump_in_place(foo, true),
+                                std::domain_error);
+                CHECK(last->next == entry);
+                CHECK(node::at(foo, tail + 1, false) == entry->next);
+
+                // the checked destructor cuts the cycle and frees every node
+                delete foo;
+            }
+        }
+    }
+}
+
+// the list formatted one element at a time through the stream, the way
+// operator<< did before it used to_chars
+template<class T>
+static std::string slow_format(const basic_node<T>* n, std::ostringstream os)
+{
+    os << '{';
+    while (n && n != n->next) {
+        os << n->data << ", ";
+        n = n->next;
+    }
+    if (n) {
+        os << n->data;
+    }
+    os << '}';
+    return os.str();
+}
+
+// digits grouped in threes, so to_chars can't be used
+struct grouped : std::numpunct<char> {
+    std::string do_grouping() const override { return "\3"; }
+};
+
+TEST_CASE("operator<< formatting")
+{
+    SUBCASE("integer payloads")
+    {
+        // longer than the formatting buffer, with extreme values
+        std::vector<int> values;
+        for (int i = 0; i < 5000; ++i) {
+            values.push_back(i * 7919 - 20'000'000);
+        }
+        values.push_back(std::numeric_limits<int>::min());
+        values.push_back(std::numeric_limits<int>::max());
+        node* foo = make_list(0);
+        for (auto it = values.rbegin(); it != values.rend(); ++it) {
+            node* n = new node(*it);
+            if (foo) {
+                n->next = foo;
+            }
+            foo = n;
+        }
+        std::ostringstream out;
+        out << foo;
+        CHECK(out.str() == slow_format<int>(foo, std::ostringstream()));
+        delete foo;
+
+        auto* big = make_list<long long>(
+            {std::numeric_limits<long long>::min(), 0, -1,
+             std::numeric_limits<long long>::max()});
+        std::ostringstream big_out;
+        big_out << big;
+        CHECK(big_out.str() == "{-9223372036854775808, 0, -1, "
+                               "9223372036854775807}");
+        delete big;
+
+        auto* u = make_list<unsigned>({0u, 4294967295u});
+        std::ostringstream u_out;
+        u_out << u;
+        CHECK(u_out.str() == "{0, 4294967295}");
+        delete u;
+    }
+    SUBCASE("stream formatting falls back")
+    {
+        node* foo = make_list({255, -3, 1000000});
+
+        std::ostringstream hex;
+        hex << std::hex;
+        std::ostringstream hex_slow;
+        hex_slow << std::hex;
+        hex << foo;
+        CHECK(hex.str() == slow_format(foo, std::move(hex_slow)));
+        CHECK(hex.str() == "{ff, fffffffd, f4240}");
+
+        std::ostringstream plus;
+        plus << std::showpos << foo;
+        CHECK(plus.str() == "{+255, -3, +1000000}");
+
+        std::ostringstream wide;
+        wide << std::setw(3) << foo;
+        CHECK(wide.str() == "  {255, -3, 1000000}");
+
+        std::ostringstream group;
+        group.imbue(std::locale(group.getloc(), new grouped));
+        group << foo;
+        CHECK(group.str() == "{255, -3, 1,000,000}");
+        delete foo;
+    }
+    SUBCASE("character payloads print as characters")
+    {
+        auto* foo = make_list<char>({'a', 'b'});
+        std::ostringstream out;
+        out << foo;
+        CHECK(out.str() == "{a, b}");
+        delete foo;
+    }
+}
+
+TEST_CASE("basic_node")
+{
+    using big = std::array<char, 256>;
+    static_assert(inline_payload<int>::value, "");
+    static_assert(!inline_payload<std::string>::value, "");
+    // out-of-line payloads keep the node to a payload pointer and `next`
+    static_assert(sizeof(basic_node<big>) == 2 * sizeof(void*), "");
+    static_assert(sizeof(basic_node<std::string>) == 2 * sizeof(void*), "");
+    static_assert(sizeof(node) == 2 * sizeof(void*), "");
+
+    SUBCASE("inline payload")
+    {
+        basic_node<double>* foo = make_list({0.5, 1.5, 2.5});
+        CHECK(basic_node<double>::size(foo) == 3);
+        CHECK(basic_node<double>::at(foo, 2)->data == 2.5);
+        std::ostringstream out;
+        out << foo;
+        CHECK(out.str() == "{0.5, 1.5, 2.5}");
+        delete foo;
+
+        basic_node<long long>* bar = make_list<long long>(4);
+        CHECK(basic_node<long long>::at(bar, 3)->data == 3);
+        delete bar;
+    }
+    SUBCASE("out-of-line payload")
+    {
+        using snode = basic_node<std::string>;
+        snode* foo = make_list<std::string>({"a", "bb", "ccc"});
+        CHECK(snode::size(foo) == 3);
+        CHECK(snode::at(foo, 1)->data == "bb");
+        CHECK_THROWS_AS(snode::at(foo, 3), std::out_of_range);
+        snode::at(foo, 0)->data += "!";
+        std::ostringstream out;
+        out << foo;
+        CHECK(out.str() == "{a!, bb, ccc}");
+
+        auto refs = do_ptr_jump(foo);
+        CHECK(refs.size() == 3);
+        for (snode* n : refs) {
+            CHECK(n->next == refs.back());
+        }
+        do_jumped_delete(refs);
+    }
+    SUBCASE("large payload")
+    {
+        big b{};
+        b[255] = 'x';
+        basic_node<big>* foo = make_list({b, b});
+        CHECK(basic_node<big>::at(foo, 1)->data[255] == 'x');
+        auto refs = do_ptr_jump_parallel(foo, 2);
+        CHECK(refs[0]->next == refs[1]);
+        do_jumped_delete(refs);
+    }
 }
 
 TEST_CASE("node")
@@ -315,6 +580,42 @@ TEST_CASE("node")
             delete foo;
         }
     }
+    SUBCASE("node::at_many")
+    {
+        node* foo = make_list({-100, 14, 2, 0, 0xbeef});
+        auto found = node::at_many(foo, {0, 0, 2, 4});
+        REQUIRE(found.size() == 4);
+        CHECK(found[0]->data == -100);
+        CHECK(found[1]->data == -100);
+        CHECK(found[2]->data == 2);
+        CHECK(found[3]->data == 0xbeef);
+        CHECK(node::at_many(foo, {}).empty());
+        CHECK(node::at_many(nullptr, {}).empty());
+        CHECK_THROWS_AS(node::at_many(nullptr, {0}), std::out_of_range);
+        CHECK_THROWS_AS(node::at_many(foo, {1, 5}), std::out_of_range);
+        CHECK_THROWS_AS(node::at_many(foo, {3, 1}), std::invalid_argument);
+        delete foo;
+    }
+    SUBCASE("~node")
+    {
+        SUBCASE("long-list")
+        {
+            // would overflow the stack with a recursive destructor
+            node* foo = make_list(10'000'000);
+            CHECK(node::size(foo) == 10'000'000);
+            delete foo;
+        }
+        SUBCASE("partial-list")
+        {
+            // deleting from the middle frees only the tail
+            node* foo = make_list(5);
+            node* mid = node::at(foo, 2);
+            node::at(foo, 1)->next = node::at(foo, 1);
+            delete mid;
+            CHECK(node::size(foo) == 2);
+            delete foo;
+        }
+    }
     SUBCASE("node::size")
     {
         SUBCASE("zero-element")
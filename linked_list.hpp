@@ -1,49 +1,672 @@
 #ifndef LINKED_LIST_HPP
 #define LINKED_LIST_HPP
 
+#include <charconv>
+#include <initializer_list>
+#include <locale>
 #include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
-#include <initializer_list>
 
-struct node {
-    int data;
-    node* next;
+#include "node_pool.hpp"
+#include "parallel.hpp"
+
+class node_arena;
+
+// whether walks along a list check for cycles by default: only in debug
+// builds. a well-formed list ends in a self-looped terminal; a corrupt one
+// whose chain loops back on itself would otherwise walk forever.
+#ifdef NDEBUG
+constexpr bool traversal_checked = false;
+#else
+constexpr bool traversal_checked = true;
+#endif
+
+// brent's cycle detection for a walk along `next` pointers.
+//
+// remembers one node and compares every node the walk steps to against it,
+// moving it up to the current node whenever the steps since the last move
+// reach a power of two. a walk stepping around a cycle is caught within about
+// twice the length of the chain leading into it plus the cycle, for one
+// comparison per step and no memory.
+class cycle_check {
+public:
+    explicit cycle_check(const void* start) : saved(start) {}
+
+    // call with each node the walk steps to. throws `std::domain_error` once a
+    // node repeats.
+    void step(const void* n)
+    {
+        if (n == saved) {
+            throw std::domain_error("cycle in list");
+        }
+        if (++steps == power) {
+            saved = n;
+            power *= 2;
+            steps = 0;
+        }
+    }
+
+private:
+    const void* saved;
+    size_t power = 1;
+    size_t steps = 0;
+};
 
-    explicit node(int data) : data(data), next(this) {}
+// whether nodes store a payload of type `T` inline or behind a pointer.
+//
+// large payloads are kept out of line so the `next` pointers that traversal
+// touches stay packed into as few cache lines as possible. specialize this for
+// a payload type to override the default.
+template<class T>
+struct inline_payload : std::bool_constant<sizeof(T) <= 2 * sizeof(void*)> {
+};
+
+// the `data` member of a node, inline or out of line. either way it is
+// accessed as `n->data`.
+template<class T, bool Inline = inline_payload<T>::value>
+struct node_payload {
+    T data;
+
+    explicit node_payload(T data) : data(std::move(data)) {}
+};
+
+template<class T>
+struct node_payload<T, false> {
+    T& data;
+
+    explicit node_payload(T data) : data(*new T(std::move(data))) {}
+    ~node_payload() { delete &data; }
+
+    node_payload(const node_payload&) = delete;
+    node_payload& operator=(const node_payload&) = delete;
+};
+
+template<class T>
+struct basic_node;
+
+// the first node of the cycle the list beginning at `start` runs into, or
+// nullptr if it ends in a terminal (or is empty). brent's algorithm: no memory
+// and no changes to the list.
+template<class T>
+basic_node<T>* find_cycle(basic_node<T>* start);
+
+template<class T>
+struct basic_node : node_payload<T> {
+    basic_node* next;
+
+    explicit basic_node(T data) : node_payload<T>(std::move(data)), next(this)
+    {
+    }
 
     // deleting a node deletes all children
-    ~node()
+    //
+    // iterative so long lists don't overflow the stack: each child is
+    // self-looped before it is deleted so its own destructor stops at once.
+    //
+    // when `traversal_checked`, a list that runs into a cycle first has the
+    // cycle cut into a terminal, so every node is still deleted once instead
+    // of the walk running into freed nodes.
+    ~basic_node()
     {
+        if constexpr (traversal_checked) {
+            if (basic_node* entry = find_cycle(this)) {
+                basic_node* last = entry;
+                while (last->next != entry) {
+                    last = last->next;
+                }
+                last->next = last;
+            }
+        }
         // stop if we're the terminal node.
-        if (this != next) {
-            delete next;
+        basic_node* n = next;
+        while (n != this) {
+            basic_node* after = n->next;
+            bool terminal = n == after;
+            n->next = n;
+            delete n;
+            if (terminal) {
+                break;
+            }
+            n = after;
+        }
+    }
+
+    // nodes small enough are allocated from a pool with per-thread free lists
+    // (see node_pool.hpp)
+    static void* operator new(size_t sz)
+    {
+        if (sz <= node_pool_block_size) {
+            return node_pool_allocate();
+        }
+        return ::operator new(sz);
+    }
+
+    static void operator delete(void* p, size_t sz)
+    {
+        if (!p) {
+            return;
+        }
+        if (sz <= node_pool_block_size) {
+            node_pool_deallocate(p);
+        }
+        else {
+            ::operator delete(p);
         }
     }
 
     // at and length are static members because they need to handle a nullptr
+    //
+    // when `checked`, walks throw `std::domain_error` on a list that runs
+    // into a cycle (see `cycle_check`).
 
     // bounds-checked element access
-    static node* at(node* start, size_t idx);
+    static basic_node* at(basic_node* start, size_t idx,
+                          bool checked = traversal_checked);
 
-    // returns the number of nodes in the list beginning at `start`
-    static size_t size(node* start);
+    // bounds-checked access to several elements in one walk. `indices` must be
+    // sorted ascending; throws `std::out_of_range` like `at` if any is out of
+    // range.
+    static std::vector<basic_node*> at_many(basic_node* start,
+                                            const std::vector<size_t>& indices,
+                                            bool checked = traversal_checked);
 
-    friend std::ostream& operator<<(std::ostream&, const node*);
+    // returns the number of nodes in the list beginning at `start`
+    static size_t size(basic_node* start, bool checked = traversal_checked);
 };
 
-// recursively redirects each node to point to the terminal node.
+using node = basic_node<int>;
+
+// always checked for cycles, the formatting costs far more. throws
+// `std::domain_error` on a list that runs into a cycle, possibly after
+// printing part of it.
+//
+// integer payloads are rendered with `std::to_chars` into a buffer that is
+// written out in large chunks, unless the stream's formatting (base, showpos,
+// width or digit grouping) would make that differ from `os << n->data`.
+template<class T>
+std::ostream& operator<<(std::ostream&, const basic_node<T>*);
+
+// redirects each node to point to the terminal node. iterative, so it runs in
+// constant stack regardless of list length.
+//
+// returns a vector of pointers to every node (in list order, terminal last) so
+// nodes that dangle after jumping can be deleted and wont leak.
 //
-// returns a vector of pointers to every node so nodes that dangle after jumping
-// can be deleted and wont leak.
-std::vector<node*> do_ptr_jump(node* start);
+// when `checked`, a list that runs into a cycle throws `std::domain_error`
+// before any node is changed. the same goes for the other jumps below.
+template<class T>
+std::vector<basic_node<T>*> do_ptr_jump(basic_node<T>* start,
+                                        bool checked = traversal_checked);
+
+// the same, but fills the caller's `refs` instead of returning a new vector.
+// `refs` is cleared first and keeps its capacity, so reusing one buffer for
+// lists no longer than it has held before makes no heap allocations.
+template<class T>
+void do_ptr_jump(basic_node<T>* start, std::vector<basic_node<T>*>& refs,
+                 bool checked = traversal_checked);
+
+// the same, also filling `rank` with each node's distance to the terminal
+// (`rank[i]` belongs to `refs[i]`, see list_rank.hpp) in the redirecting
+// pass, so no separate walk is needed to rank the list.
+template<class T>
+void do_ptr_jump(basic_node<T>* start, std::vector<basic_node<T>*>& refs,
+                 std::vector<size_t>& rank, bool checked = traversal_checked);
+
+// same result as `do_ptr_jump`, computed with synchronous wyllie pointer
+// jumping rounds (each node's next becomes next->next) spread across `threads`
+// worker threads. `threads == 0` uses the hardware concurrency.
+//
+// it can't beat `do_ptr_jump`: the sequential walk that numbers the nodes
+// already finds the terminal, so the O(n log(n)) rounds only recompute a known
+// result. it is kept as the reference wyllie implementation on nodes; for a
+// real parallel speedup jump an `index_list` (`do_ptr_jump_parallel(
+// index_list&, threads)` or `do_ptr_jump_simd`), where there is no sequential
+// walk to pay first.
+template<class T>
+std::vector<basic_node<T>*> do_ptr_jump_parallel(basic_node<T>* start,
+                                                 unsigned threads,
+                                                 bool checked = traversal_checked);
 
 // logic to delete the nodes after doing pointer jumping.
 // ensures each node is deleted and the terminal node is only deleted once.
-void do_jumped_delete(std::vector<node*>& lst);
+template<class T>
+void do_jumped_delete(std::vector<basic_node<T>*>& lst);
+
+// redirects each node to point to the terminal node in two walks (one to find
+// the terminal, one to redirect) without recording the nodes, so it needs no
+// memory beyond the list itself. returns the terminal node, or nullptr for an
+// empty list.
+//
+// only for lists whose nodes are owned elsewhere, e.g. by a `node_arena`:
+// after jumping nothing else can reach them.
+template<class T>
+basic_node<T>* do_ptr_jump_in_place(basic_node<T>* start,
+                                    bool checked = traversal_checked);
+
+// whether `do_jumped_delete(node_arena&)` checks the lists by default: only in
+// debug builds.
+#ifdef NDEBUG
+constexpr bool jumped_delete_checked = false;
+#else
+constexpr bool jumped_delete_checked = true;
+#endif
+
+// frees the nodes of jumped lists allocated from `arena` all at once by
+// releasing it.
+//
+// when `checked`, first verifies every node in the arena points directly at a
+// terminal and throws `std::domain_error` (freeing nothing) if one doesn't,
+// like `do_jumped_delete(std::vector<node*>&)`.
+void do_jumped_delete(node_arena& arena,
+                      bool checked = jumped_delete_checked);
 
 // create a list with data elements 0..nelts
-node* make_list(size_t nelts);
+template<class T = int>
+basic_node<T>* make_list(size_t nelts);
 // create a list with the given data elements
-node* make_list(std::initializer_list<int> lst);
+template<class T = int>
+basic_node<T>* make_list(std::initializer_list<T> lst);
+
+// the same, but the nodes are placed contiguously in `arena` instead of being
+// allocated one at a time. the list is freed by releasing the arena.
+node* make_list(size_t nelts, node_arena& arena);
+node* make_list(std::initializer_list<int> lst, node_arena& arena);
+
+// template definitions
+
+template<class T>
+basic_node<T>* make_list(size_t nelts)
+{
+    if (nelts < 1) {
+        return nullptr;
+    }
+    basic_node<T>* root = new basic_node<T>(T(0));
+    basic_node<T>* curr = root;
+    for (size_t i = 1; i < nelts; ++i) {
+        curr->next = new basic_node<T>(T(i));
+        curr = curr->next;
+    }
+    return root;
+}
+
+template<class T>
+basic_node<T>* make_list(std::initializer_list<T> lst)
+{
+    if (lst.size() == 0) {
+        return nullptr;
+    }
+    const T* d = lst.begin();
+    basic_node<T>* root = new basic_node<T>(*d++);
+    basic_node<T>* curr = root;
+    while (d != lst.end()) {
+        curr->next = new basic_node<T>(*d++);
+        curr = curr->next;
+    }
+    return root;
+}
+
+template<class T>
+basic_node<T>* find_cycle(basic_node<T>* start)
+{
+    if (!start) {
+        return nullptr;
+    }
+    // the hare walks, the tortoise jumps up to it at powers of two
+    basic_node<T>* tortoise = start;
+    basic_node<T>* hare = start;
+    size_t power = 1;
+    size_t lam = 0;
+    while (true) {
+        if (hare == hare->next) {
+            return nullptr;
+        }
+        hare = hare->next;
+        ++lam;
+        if (hare == tortoise) {
+            break;
+        }
+        if (lam == power) {
+            tortoise = hare;
+            power *= 2;
+            lam = 0;
+        }
+    }
+    // lam is the cycle length, so a hare lam nodes ahead meets the tortoise
+    // where the cycle begins
+    tortoise = hare = start;
+    for (size_t i = 0; i < lam; ++i) {
+        hare = hare->next;
+    }
+    while (tortoise != hare) {
+        tortoise = tortoise->next;
+        hare = hare->next;
+    }
+    return tortoise;
+}
+
+template<class T>
+basic_node<T>* basic_node<T>::at(basic_node* start, size_t idx, bool checked)
+{
+    if (!start) {
+        throw std::out_of_range("empty list");
+    }
+    basic_node* tgt = start;
+    cycle_check cycle(start);
+    for (size_t i = 0; i < idx; ++i) {
+        // bounds check
+        if (tgt == tgt->next) {
+            throw std::out_of_range("index >= size");
+        }
+        tgt = tgt->next;
+        if (checked) {
+            cycle.step(tgt);
+        }
+    }
+    return tgt;
+}
+
+template<class T>
+std::vector<basic_node<T>*>
+basic_node<T>::at_many(basic_node* start, const std::vector<size_t>& indices,
+                       bool checked)
+{
+    std::vector<basic_node*> found;
+    found.reserve(indices.size());
+    if (indices.empty()) {
+        return found;
+    }
+    if (!start) {
+        throw std::out_of_range("empty list");
+    }
+    basic_node* tgt = start;
+    size_t pos = 0;
+    cycle_check cycle(start);
+    for (size_t idx : indices) {
+        if (idx < pos) {
+            throw std::invalid_argument("indices not sorted");
+        }
+        for (; pos < idx; ++pos) {
+            // bounds check
+            if (tgt == tgt->next) {
+                throw std::out_of_range("index >= size");
+            }
+            tgt = tgt->next;
+            if (checked) {
+                cycle.step(tgt);
+            }
+        }
+        found.push_back(tgt);
+    }
+    return found;
+}
+
+template<class T>
+size_t basic_node<T>::size(basic_node* start, bool checked)
+{
+    if (!start) {
+        return 0;
+    }
+    basic_node* curr = start;
+    size_t sz = 1;
+
+    cycle_check cycle(start);
+    while (curr->next != curr) {
+        ++sz;
+        curr = curr->next;
+        if (checked) {
+            cycle.step(curr);
+        }
+    }
+    return sz;
+}
+
+// whether `os << data` for a `T` is plain `std::to_chars` output. character
+// types and bool are printed as characters or words.
+template<class T>
+constexpr bool to_chars_payload =
+    std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+    !std::is_same_v<T, char> && !std::is_same_v<T, signed char> &&
+    !std::is_same_v<T, unsigned char> && !std::is_same_v<T, wchar_t> &&
+    !std::is_same_v<T, char16_t> && !std::is_same_v<T, char32_t>;
+
+// whether `os` would print integers exactly like `std::to_chars`
+inline bool plain_int_format(const std::ostream& os)
+{
+    std::ios_base::fmtflags base = os.flags() & std::ios_base::basefield;
+    if (base == std::ios_base::oct || base == std::ios_base::hex ||
+        (os.flags() & std::ios_base::showpos) || os.width() != 0) {
+        return false;
+    }
+    return std::use_facet<std::numpunct<char>>(os.getloc()).grouping().empty();
+}
+
+template<class T>
+std::ostream& format_to_chars(std::ostream& os, const basic_node<T>* n)
+{
+    // flushed whenever fewer than `slack` bytes are left, which fits any
+    // integer and its separator or the closing brace
+    constexpr size_t cap = 16384;
+    constexpr size_t slack = 64;
+    char buf[cap];
+    char* p = buf;
+    *p++ = '{';
+    cycle_check cycle(n);
+    while (n) {
+        if (size_t(buf + cap - p) < slack) {
+            os.write(buf, p - buf);
+            p = buf;
+        }
+        p = std::to_chars(p, p + slack - 2, n->data).ptr;
+        if (n == n->next) {
+            break;
+        }
+        *p++ = ',';
+        *p++ = ' ';
+        n = n->next;
+        cycle.step(n);
+    }
+    *p++ = '}';
+    return os.write(buf, p - buf);
+}
+
+template<class T>
+std::ostream& operator<<(std::ostream& os, const basic_node<T>* n)
+{
+    if constexpr (to_chars_payload<T>) {
+        if (plain_int_format(os)) {
+            return format_to_chars(os, n);
+        }
+    }
+    os << '{';
+    cycle_check cycle(n);
+    while (n && n != n->next) {
+        os << n->data << ", ";
+        n = n->next;
+        cycle.step(n);
+    }
+    if (n) {
+        os << n->data;
+    }
+    return os << '}';
+}
+
+// performs the pointer jumping algorithm iteratively.
+//
+// the first pass records a pointer to each node in `refs` (so the nodes left
+// dangling after jumping can be deleted) and finds the terminal node. the
+// second pass redirects every node to the terminal. uses constant stack so it
+// is safe on arbitrarily long lists.
+template<class T>
+std::vector<basic_node<T>*> do_ptr_jump(basic_node<T>* start, bool checked)
+{
+    // save references to the nodes that will dangle after jumping
+    std::vector<basic_node<T>*> refs;
+    do_ptr_jump(start, refs, checked);
+    return refs;
+}
+
+template<class T>
+void do_ptr_jump(basic_node<T>* start, std::vector<basic_node<T>*>& refs,
+                 bool checked)
+{
+    // keeps the capacity, so a reused buffer doesn't reallocate
+    refs.clear();
+    if (!start) {
+        return;
+    }
+
+    basic_node<T>* n = start;
+    cycle_check cycle(start);
+    while (n != n->next) {
+        refs.push_back(n);
+        n = n->next;
+        if (checked) {
+            cycle.step(n);
+        }
+    }
+    refs.push_back(n);
+
+    // n is the terminal node
+    for (basic_node<T>* r : refs) {
+        r->next = n;
+    }
+}
+
+template<class T>
+void do_ptr_jump(basic_node<T>* start, std::vector<basic_node<T>*>& refs,
+                 std::vector<size_t>& rank, bool checked)
+{
+    refs.clear();
+    rank.clear();
+    if (!start) {
+        return;
+    }
+
+    basic_node<T>* n = start;
+    cycle_check cycle(start);
+    while (n != n->next) {
+        refs.push_back(n);
+        n = n->next;
+        if (checked) {
+            cycle.step(n);
+        }
+    }
+    refs.push_back(n);
+
+    // n is the terminal node
+    const size_t len = refs.size();
+    rank.resize(len);
+    for (size_t i = 0; i < len; ++i) {
+        refs[i]->next = n;
+        rank[i] = len - 1 - i;
+    }
+}
+
+// performs wyllie's pointer jumping in synchronous rounds across `threads`
+// workers.
+//
+// nodes are numbered in list order and each round replaces every successor
+// index with its successor's successor, reading one buffer and writing the
+// other so a round never sees its own writes. after ceil(log2(n)) rounds every
+// index refers to the terminal and the result is written back to the nodes.
+template<class T>
+std::vector<basic_node<T>*> do_ptr_jump_parallel(basic_node<T>* start,
+                                                 unsigned threads, bool checked)
+{
+    std::vector<basic_node<T>*> refs;
+    if (!start) {
+        return refs;
+    }
+
+    basic_node<T>* n = start;
+    cycle_check cycle(start);
+    while (n != n->next) {
+        refs.push_back(n);
+        n = n->next;
+        if (checked) {
+            cycle.step(n);
+        }
+    }
+    refs.push_back(n);
+
+    const size_t len = refs.size();
+    size_t rounds = 0;
+    while ((size_t(1) << rounds) < len) {
+        ++rounds;
+    }
+
+    // double-buffered successor indices
+    std::vector<size_t> succ_a(len);
+    std::vector<size_t> succ_b(len);
+
+    run_threads(threads, [&](unsigned tid, unsigned nthreads, barrier& sync) {
+        auto [lo, hi] = block_range(len, tid, nthreads);
+        for (size_t i = lo; i < hi; ++i) {
+            succ_a[i] = i + 1 < len ? i + 1 : i;
+        }
+        size_t* in = succ_a.data();
+        size_t* out = succ_b.data();
+        for (size_t r = 0; r < rounds; ++r) {
+            // wait for the previous round (or initialization) to finish
+            sync.wait();
+            for (size_t i = lo; i < hi; ++i) {
+                out[i] = in[in[i]];
+            }
+            std::swap(in, out);
+        }
+        for (size_t i = lo; i < hi; ++i) {
+            refs[i]->next = refs[in[i]];
+        }
+    });
+
+    return refs;
+}
+
+// given the list of nodes all pointing to the terminal node, correctly delete
+// all the nodes.
+//
+// tested with valgrind
+template<class T>
+void do_jumped_delete(std::vector<basic_node<T>*>& lst)
+{
+    if (lst.size() == 0) {
+        return;
+    }
+    basic_node<T>* terminal = lst[0]->next;
+    for (basic_node<T>* n : lst) {
+        if (n->next != terminal) {
+            throw std::domain_error("deleting non-jumped list");
+        }
+        // ensure terminal is only deleted once.
+        n->next = n;
+        delete n;
+    }
+}
+
+template<class T>
+basic_node<T>* do_ptr_jump_in_place(basic_node<T>* start, bool checked)
+{
+    if (!start) {
+        return nullptr;
+    }
+    basic_node<T>* terminal = start;
+    cycle_check cycle(start);
+    while (terminal != terminal->next) {
+        terminal = terminal->next;
+        if (checked) {
+            cycle.step(terminal);
+        }
+    }
+    basic_node<T>* n = start;
+    while (n != terminal) {
+        basic_node<T>* after = n->next;
+        n->next = terminal;
+        n = after;
+    }
+    return terminal;
+}
 
 #endif
@@ -0,0 +1,248 @@
+#include <stdexcept>
+#include <utility>
+
+#include "list.hpp"
+
+list::list(size_t nelts) : list()
+{
+    for (size_t i = 0; i < nelts; ++i) {
+        push_back(i);
+    }
+}
+
+list::list(std::initializer_list<int> lst) : list()
+{
+    for (int d : lst) {
+        push_back(d);
+    }
+}
+
+list list::adopt(node* start)
+{
+    list lst;
+    lst.head_ = start;
+    if (start) {
+        lst.tail_ = start;
+        lst.len = 1;
+        while (lst.tail_ != lst.tail_->next) {
+            lst.tail_ = lst.tail_->next;
+            ++lst.len;
+        }
+    }
+    return lst;
+}
+
+list::list(list&& other) noexcept
+    : head_(other.head_), tail_(other.tail_), len(other.len)
+{
+    other.head_ = other.tail_ = nullptr;
+    other.len = 0;
+}
+
+list& list::operator=(list&& other) noexcept
+{
+    if (this != &other) {
+        delete head_;
+        head_ = other.head_;
+        tail_ = other.tail_;
+        len = other.len;
+        other.head_ = other.tail_ = nullptr;
+        other.len = 0;
+    }
+    return *this;
+}
+
+void list::push_back(int data)
+{
+    node* n = new node(data);
+    if (tail_) {
+        tail_->next = n;
+    }
+    else {
+        head_ = n;
+    }
+    tail_ = n;
+    ++len;
+}
+
+void list::push_front(int data)
+{
+    node* n = new node(data);
+    if (head_) {
+        n->next = head_;
+    }
+    else {
+        tail_ = n;
+    }
+    head_ = n;
+    ++len;
+}
+
+void list::pop_front()
+{
+    if (!head_) {
+        throw std::out_of_range("empty list");
+    }
+    node* old = head_;
+    if (head_ == tail_) {
+        head_ = tail_ = nullptr;
+    }
+    else {
+        head_ = head_->next;
+    }
+    // detach so only the old head is deleted
+    old->next = old;
+    delete old;
+    --len;
+}
+
+void list::splice_back(list& other)
+{
+    if (&other == this || !other.head_) {
+        return;
+    }
+    if (tail_) {
+        tail_->next = other.head_;
+    }
+    else {
+        head_ = other.head_;
+    }
+    tail_ = other.tail_;
+    len += other.len;
+    other.head_ = other.tail_ = nullptr;
+    other.len = 0;
+}
+
+node* list::release()
+{
+    node* n = head_;
+    head_ = tail_ = nullptr;
+    len = 0;
+    return n;
+}
+
+std::ostream& operator<<(std::ostream& os, const list& lst)
+{
+    return os << static_cast<const node*>(lst.head_);
+}
+
+void do_ptr_jump(list& lst, std::vector<node*>& refs)
+{
+    refs.clear();
+    refs.reserve(lst.size());
+    do_ptr_jump(lst.release(), refs);
+}
+
+#ifdef TESTING
+#include "doctest.h"
+#include <atomic>
+#include <sstream>
+
+TEST_CASE("list")
+{
+    SUBCASE("construct")
+    {
+        list empty;
+        CHECK(empty.size() == 0);
+        CHECK(empty.head() == nullptr);
+        CHECK(empty.tail() == nullptr);
+        CHECK_THROWS(empty.at(0));
+
+        list foo(5);
+        CHECK(foo.size() == 5);
+        CHECK(node::size(foo.head()) == 5);
+        CHECK(foo.tail() == foo.at(4));
+        CHECK(foo.tail()->next == foo.tail());
+
+        list bar{4, 3, 2, 1, 0};
+        CHECK(bar.size() == 5);
+        CHECK(bar.at(0)->data == 4);
+        CHECK(bar.tail()->data == 0);
+    }
+    SUBCASE("adopt")
+    {
+        list foo = list::adopt(make_list(7));
+        CHECK(foo.size() == 7);
+        CHECK(foo.tail()->data == 6);
+        CHECK(list::adopt(nullptr).size() == 0);
+    }
+    SUBCASE("push and pop")
+    {
+        list foo;
+        foo.push_back(1);
+        foo.push_back(2);
+        foo.push_front(0);
+        CHECK(foo.size() == 3);
+        CHECK(node::size(foo.head()) == 3);
+        CHECK(foo.tail()->data == 2);
+        std::ostringstream out;
+        out << foo;
+        CHECK(out.str() == "{0, 1, 2}");
+
+        foo.pop_front();
+        foo.pop_front();
+        CHECK(foo.size() == 1);
+        CHECK(foo.head() == foo.tail());
+        foo.pop_front();
+        CHECK(foo.empty());
+        CHECK(foo.tail() == nullptr);
+        CHECK_THROWS_AS(foo.pop_front(), std::out_of_range);
+
+        // push_front onto an empty list sets the tail too
+        foo.push_front(9);
+        CHECK(foo.tail()->data == 9);
+    }
+    SUBCASE("splice_back")
+    {
+        list foo{1, 2};
+        list bar{3, 4, 5};
+        list empty;
+        foo.splice_back(bar);
+        foo.splice_back(empty);
+        CHECK(foo.size() == 5);
+        CHECK(bar.empty());
+        CHECK(foo.tail()->data == 5);
+        CHECK(node::size(foo.head()) == 5);
+        empty.splice_back(foo);
+        CHECK(empty.size() == 5);
+        CHECK(foo.empty());
+    }
+    SUBCASE("do_ptr_jump")
+    {
+        // defined with the allocation-counting operator new in the tests
+        extern std::atomic<size_t> test_alloc_count;
+
+        list foo(1000);
+        std::vector<node*> refs;
+        size_t before = test_alloc_count.load();
+        do_ptr_jump(foo, refs);
+        // the single up-front reservation
+        CHECK(test_alloc_count.load() == before + 1);
+        CHECK(foo.empty());
+        REQUIRE(refs.size() == 1000);
+        CHECK(refs[0]->next == refs.back());
+        do_jumped_delete(refs);
+
+        list bar(500);
+        before = test_alloc_count.load();
+        do_ptr_jump(bar, refs);
+        CHECK(test_alloc_count.load() == before);
+        CHECK(refs.size() == 500);
+        do_jumped_delete(refs);
+    }
+    SUBCASE("move and release")
+    {
+        list foo(3);
+        list bar(std::move(foo));
+        CHECK(foo.empty());
+        CHECK(bar.size() == 3);
+        foo = std::move(bar);
+        CHECK(foo.size() == 3);
+        node* n = foo.release();
+        CHECK(foo.empty());
+        CHECK(node::size(n) == 3);
+        delete n;
+    }
+}
+
+#endif
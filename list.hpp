@@ -0,0 +1,68 @@
+#ifndef LIST_HPP
+#define LIST_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
+#include <vector>
+
+#include "linked_list.hpp"
+
+// owning header for a `node` chain.
+//
+// caches the length and the tail, keeping them up to date through its own
+// mutation api, so `size`, `tail` and appending are O(1). the chain itself is
+// an ordinary `node` list and can be handed to the free functions through
+// `head`, as long as they don't change its length.
+class list {
+public:
+    list() : head_(nullptr), tail_(nullptr), len(0) {}
+    // a list with data elements 0..nelts
+    explicit list(size_t nelts);
+    // a list with the given data elements
+    list(std::initializer_list<int> lst);
+    // takes ownership of the chain beginning at `start`, measuring it once
+    static list adopt(node* start);
+
+    ~list() { delete head_; }
+
+    list(const list&) = delete;
+    list& operator=(const list&) = delete;
+    list(list&& other) noexcept;
+    list& operator=(list&& other) noexcept;
+
+    size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+
+    node* head() const { return head_; }
+    // the terminal node
+    node* tail() const { return tail_; }
+
+    // bounds-checked element access
+    node* at(size_t idx) const { return node::at(head_, idx); }
+
+    void push_back(int data);
+    void push_front(int data);
+    // removes the first element. throws `std::out_of_range` when empty.
+    void pop_front();
+    // moves all of `other`'s nodes onto the end of this list in O(1)
+    void splice_back(list& other);
+
+    // gives up ownership of the chain and leaves the list empty
+    node* release();
+
+    friend std::ostream& operator<<(std::ostream&, const list&);
+
+private:
+    node* head_;
+    node* tail_;
+    size_t len;
+};
+
+// pointer jumps `lst` into `refs` like `do_ptr_jump(node*, refs)`, reserving
+// the known size up front so `refs` is allocated at most once. ownership of
+// the nodes passes to `refs` (free them with `do_jumped_delete`) and `lst` is
+// left empty.
+void do_ptr_jump(list& lst, std::vector<node*>& refs);
+
+#endif
@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <random>
+#include <utility>
+
+#include "list_rank.hpp"
+#include "parallel.hpp"
+
+// wyllie list ranking over the successor indices `next`, which is consumed.
+// returns the rank of each index.
+template<class Index>
+static std::vector<Index> wyllie_rank(std::vector<Index>& next,
+                                      unsigned threads)
+{
+    const size_t n = next.size();
+    size_t rounds = 0;
+    while ((size_t(1) << rounds) < n) {
+        ++rounds;
+    }
+
+    // double-buffered successors and ranks
+    std::vector<Index> next_b(n);
+    std::vector<Index> rank_a(n);
+    std::vector<Index> rank_b(n);
+
+    run_threads(threads, [&](unsigned tid, unsigned nthreads, barrier& sync) {
+        auto [lo, hi] = block_range(n, tid, nthreads);
+        for (size_t i = lo; i < hi; ++i) {
+            rank_a[i] = next[i] == i ? 0 : 1;
+        }
+        Index* s_in = next.data();
+        Index* s_out = next_b.data();
+        Index* r_in = rank_a.data();
+        Index* r_out = rank_b.data();
+        for (size_t r = 0; r < rounds; ++r) {
+            sync.wait();
+            for (size_t i = lo; i < hi; ++i) {
+                // the terminal has rank 0 so adding it is harmless
+                r_out[i] = r_in[i] + r_in[s_in[i]];
+                s_out[i] = s_in[s_in[i]];
+            }
+            std::swap(s_in, s_out);
+            std::swap(r_in, r_out);
+        }
+    });
+
+    return rounds % 2 == 0 ? rank_a : rank_b;
+}
+
+std::vector<size_t> list_rank(const node* start)
+{
+    size_t len = 0;
+    for (const node* n = start; n; n = n == n->next ? nullptr : n->next) {
+        ++len;
+    }
+    std::vector<size_t> rank(len);
+    for (size_t i = 0; i < len; ++i) {
+        rank[i] = len - 1 - i;
+    }
+    return rank;
+}
+
+std::vector<uint32_t> list_rank(const index_list& lst)
+{
+    const size_t len = lst.next.size();
+    std::vector<uint32_t> rank(len);
+    if (len == 0) {
+        return rank;
+    }
+    // every element is on the chain, so walking it gives each one's position
+    uint32_t i = lst.head;
+    for (size_t pos = 0; pos < len; ++pos) {
+        rank[i] = len - 1 - pos;
+        i = lst.next[i];
+    }
+    return rank;
+}
+
+std::vector<uint32_t> list_rank_parallel(const index_list& lst,
+                                         unsigned threads)
+{
+    std::vector<uint32_t> next = lst.next;
+    return wyllie_rank(next, threads);
+}
+
+std::vector<uint32_t> list_rank_sublists(const index_list& lst,
+                                         unsigned threads,
+                                         size_t sublists_per_thread)
+{
+    const uint32_t none = uint32_t(-1);
+    const size_t n = lst.next.size();
+    std::vector<uint32_t> rank(n);
+    if (n == 0) {
+        return rank;
+    }
+    if (threads == 0) {
+        threads = default_threads();
+    }
+
+    // choose the splitters: the head, then distinct random elements
+    const size_t count =
+        std::min(n, std::max<size_t>(1, threads * sublists_per_thread));
+    std::vector<uint32_t> splitter_of(n, none);
+    std::vector<uint32_t> starts;
+    starts.reserve(count);
+    splitter_of[lst.head] = 0;
+    starts.push_back(lst.head);
+    std::mt19937 rng(n);
+    std::uniform_int_distribution<size_t> pick(0, n - 1);
+    for (size_t tries = 0; starts.size() < count && tries < 4 * count;
+         ++tries) {
+        uint32_t e = pick(rng);
+        if (splitter_of[e] == none) {
+            splitter_of[e] = starts.size();
+            starts.push_back(e);
+        }
+    }
+    const size_t sublists = starts.size();
+
+    // per sublist: its length, the sublist after it and its offset from the
+    // head. per element: its sublist and its offset within it.
+    std::vector<uint32_t> length(sublists);
+    std::vector<uint32_t> succ(sublists);
+    std::vector<uint32_t> offset(sublists);
+    std::vector<uint32_t> owner(n);
+    std::vector<uint32_t>& local = rank;
+
+    run_threads(threads, [&](unsigned tid, unsigned nthreads, barrier& sync) {
+        auto [lo, hi] = block_range(sublists, tid, nthreads);
+        for (size_t j = lo; j < hi; ++j) {
+            uint32_t e = starts[j];
+            uint32_t off = 0;
+            while (true) {
+                owner[e] = j;
+                local[e] = off++;
+                uint32_t nx = lst.next[e];
+                if (nx == e) {
+                    succ[j] = none;
+                    break;
+                }
+                if (splitter_of[nx] != none) {
+                    succ[j] = splitter_of[nx];
+                    break;
+                }
+                e = nx;
+            }
+            length[j] = off;
+        }
+        sync.wait();
+
+        // the reduced list is short, so one thread ranks it
+        if (tid == 0) {
+            uint32_t total = 0;
+            for (uint32_t j = 0; j != none; j = succ[j]) {
+                offset[j] = total;
+                total += length[j];
+            }
+        }
+        sync.wait();
+
+        auto [first, last] = block_range(n, tid, nthreads);
+        for (size_t i = first; i < last; ++i) {
+            rank[i] = n - 1 - (offset[owner[i]] + local[i]);
+        }
+    });
+    return rank;
+}
+
+#ifdef TESTING
+#include "doctest.h"
+
+TEST_CASE("list_rank")
+{
+    SUBCASE("node")
+    {
+        for (size_t len : {0, 1, 2, 5, 1000, 1025}) {
+            CAPTURE(len);
+            node* foo = make_list(len);
+            auto seq = list_rank(foo);
+            REQUIRE(seq.size() == len);
+            for (size_t i = 0; i < len; ++i) {
+                CHECK(seq[i] == len - 1 - i);
+            }
+            if (len > 0) {
+                CHECK(node::size(foo) == seq[0] + 1);
+            }
+            delete foo;
+        }
+    }
+    SUBCASE("index_list")
+    {
+        for (size_t len : {0, 1, 2, 5, 1000, 1025}) {
+            CAPTURE(len);
+            index_list lst = make_index_list(len);
+            auto seq = list_rank(lst);
+            auto par = list_rank_parallel(lst, 2);
+            REQUIRE(seq.size() == len);
+            for (size_t i = 0; i < len; ++i) {
+                CHECK(seq[i] == len - 1 - i);
+                CHECK(par[i] == len - 1 - i);
+            }
+        }
+    }
+    SUBCASE("index_list sublists")
+    {
+        for (size_t len : {1, 2, 5, 100, 1025, 20000}) {
+            CAPTURE(len);
+            index_list lst = make_permuted_index_list(len, len);
+
+            auto expect = list_rank(lst);
+            CHECK(list_rank_sublists(lst, 1) == expect);
+            CHECK(list_rank_sublists(lst, 3) == expect);
+            CHECK(list_rank_sublists(lst, 4, 1) == expect);
+            CHECK(list_rank_sublists(lst, 2, 100000) == expect);
+        }
+        CHECK(list_rank_sublists(index_list(), 2).empty());
+    }
+    SUBCASE("index_list out of storage order")
+    {
+        // list order 3 -> 1 -> 4 -> 0 -> 2
+        index_list lst;
+        lst.data = {0, 0, 0, 0, 0};
+        lst.next = {2, 4, 2, 1, 0};
+        lst.head = 3;
+        std::vector<uint32_t> expect{1, 3, 0, 4, 2};
+        CHECK(list_rank(lst) == expect);
+        CHECK(list_rank_parallel(lst, 1) == expect);
+        CHECK(list_rank_parallel(lst, 4) == expect);
+    }
+}
+
+#endif
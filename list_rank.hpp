@@ -0,0 +1,41 @@
+#ifndef LIST_RANK_HPP
+#define LIST_RANK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "index_list.hpp"
+#include "linked_list.hpp"
+
+// list ranking: the rank of an element is its distance to the terminal, so the
+// terminal has rank 0 and the head has rank size - 1.
+
+// ranks of the nodes beginning at `start`, in list order (the same order as the
+// refs returned by `do_ptr_jump`, so `rank[i]` belongs to `refs[i]`). a
+// separate counting walk that doesn't modify the list; to rank a list that is
+// being jumped anyway, use the `do_ptr_jump` overload that fills the ranks.
+std::vector<size_t> list_rank(const node* start);
+
+// ranks of the elements of `lst`, keyed by element index. every element must
+// be on the chain from `lst.head`.
+std::vector<uint32_t> list_rank(const index_list& lst);
+
+// the same, computed with wyllie pointer jumping across `threads` worker
+// threads: each round adds the successor's rank to every element's rank and
+// then jumps the successor. `threads == 0` uses the hardware concurrency.
+std::vector<uint32_t> list_rank_parallel(const index_list& lst,
+                                         unsigned threads);
+
+// work-efficient parallel ranking (helman and jaja's sparse ruling set).
+//
+// picks `sublists_per_thread` splitter elements per thread (always including
+// the head), walks the sublist from each splitter to the next concurrently,
+// ranks the short list of sublists sequentially and then broadcasts each
+// sublist's offset back to its elements. O(n) work where wyllie does
+// O(n log(n)). `threads == 0` uses the hardware concurrency.
+std::vector<uint32_t> list_rank_sublists(const index_list& lst,
+                                         unsigned threads,
+                                         size_t sublists_per_thread = 32);
+
+#endif
@@ -0,0 +1,78 @@
+#include "list_scan.hpp"
+
+#ifdef TESTING
+#include "doctest.h"
+
+#include <algorithm>
+#include <functional>
+
+TEST_CASE("list_scan")
+{
+    using ll = long long;
+    SUBCASE("sum")
+    {
+        for (size_t len : {0, 1, 2, 5, 1000, 1025}) {
+            CAPTURE(len);
+            node* foo = make_list(len);
+            index_list bar = make_index_list(len);
+            auto incl = list_scan(foo, std::plus<ll>(), 0LL);
+            auto excl =
+                list_scan(foo, std::plus<ll>(), 0LL, scan_kind::exclusive);
+            auto par = list_scan_parallel(foo, std::plus<ll>(), 0LL, 3);
+            auto soa = list_scan_parallel(bar, std::plus<ll>(), 0LL, 2);
+            auto soa_seq = list_scan(bar, std::plus<ll>(), 0LL);
+            REQUIRE(incl.size() == len);
+            REQUIRE(excl.size() == len);
+            for (size_t i = 0; i < len; ++i) {
+                ll expect = ll(i) * (ll(i) + 1) / 2;
+                CHECK(incl[i] == expect);
+                CHECK(excl[i] == expect - ll(i));
+                CHECK(par[i] == expect);
+                CHECK(soa[i] == expect);
+                CHECK(soa_seq[i] == expect);
+            }
+            delete foo;
+        }
+    }
+    SUBCASE("non-commutative")
+    {
+        // keeping the left operand is associative but not commutative
+        auto first = [](int a, int b) { return a; };
+        auto last = [](int a, int b) { return b; };
+        node* foo = make_list({7, 3, 9, 1});
+        CHECK(list_scan(foo, first, 0) == std::vector<int>{7, 7, 7, 7});
+        CHECK(list_scan(foo, last, 0) == std::vector<int>{7, 3, 9, 1});
+        CHECK(list_scan(foo, last, -1, scan_kind::exclusive) ==
+              std::vector<int>{-1, 7, 3, 9});
+        CHECK(list_scan(foo, first, -1, scan_kind::exclusive) ==
+              std::vector<int>{-1, 7, 7, 7});
+        // the wyllie rounds must keep the predecessor on the left too
+        CHECK(list_scan_parallel(foo, first, 0, 3) ==
+              std::vector<int>{7, 7, 7, 7});
+        CHECK(list_scan_parallel(foo, last, 0, 3) ==
+              std::vector<int>{7, 3, 9, 1});
+        CHECK(list_scan_parallel(foo, first, -1, 3, scan_kind::exclusive) ==
+              std::vector<int>{-1, 7, 7, 7});
+        CHECK(list_scan_parallel(foo, last, -1, 3, scan_kind::exclusive) ==
+              std::vector<int>{-1, 7, 3, 9});
+        delete foo;
+    }
+    SUBCASE("index_list out of storage order")
+    {
+        // list order 3 -> 1 -> 4 -> 0 -> 2
+        index_list lst;
+        lst.data = {1, 2, 3, 4, 5};
+        lst.next = {2, 4, 2, 1, 0};
+        lst.head = 3;
+        auto mx = [](int a, int b) { return std::max(a, b); };
+        // data in list order: 4, 2, 5, 1, 3
+        CHECK(list_scan(lst, std::plus<int>(), 0) ==
+              std::vector<int>{12, 6, 15, 4, 11});
+        CHECK(list_scan(lst, mx, 0, scan_kind::exclusive) ==
+              std::vector<int>{5, 4, 5, 0, 4});
+        CHECK(list_scan_parallel(lst, mx, 0, 4, scan_kind::exclusive) ==
+              std::vector<int>{5, 4, 5, 0, 4});
+    }
+}
+
+#endif
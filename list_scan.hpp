@@ -0,0 +1,177 @@
+#ifndef LIST_SCAN_HPP
+#define LIST_SCAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "index_list.hpp"
+#include "linked_list.hpp"
+#include "parallel.hpp"
+
+// prefix scans along a list: element i of an inclusive scan is
+// `data[0] op data[1] op ... op data[i]` in list order, an exclusive scan
+// stops at `data[i - 1]` (and is `identity` for the head). `op` must be
+// associative but need not be commutative.
+enum class scan_kind { inclusive, exclusive };
+
+// wyllie scan over predecessor indices: every round combines each value with
+// its predecessor's and then jumps the predecessor, so after ceil(log2(n))
+// rounds every element holds the combination of everything before it.
+//
+// `pred` holds `none` for the head and is consumed; `val` is replaced by the
+// inclusive scan. an implementation detail of the functions below.
+template<class T, class BinaryOp, class Index>
+void wyllie_scan(std::vector<Index>& pred, std::vector<T>& val, BinaryOp op,
+                 unsigned threads)
+{
+    const Index none = Index(-1);
+    const size_t n = val.size();
+    size_t rounds = 0;
+    while ((size_t(1) << rounds) < n) {
+        ++rounds;
+    }
+
+    // double-buffered predecessors and values
+    std::vector<Index> pred_b(n);
+    std::vector<T> val_b(n);
+
+    run_threads(threads, [&](unsigned tid, unsigned nthreads, barrier& sync) {
+        auto [lo, hi] = block_range(n, tid, nthreads);
+        Index* p_in = pred.data();
+        Index* p_out = pred_b.data();
+        T* v_in = val.data();
+        T* v_out = val_b.data();
+        for (size_t r = 0; r < rounds; ++r) {
+            sync.wait();
+            for (size_t i = lo; i < hi; ++i) {
+                Index p = p_in[i];
+                if (p == none) {
+                    v_out[i] = v_in[i];
+                    p_out[i] = none;
+                }
+                else {
+                    v_out[i] = op(v_in[p], v_in[i]);
+                    p_out[i] = p_in[p];
+                }
+            }
+            std::swap(p_in, p_out);
+            std::swap(v_in, v_out);
+        }
+    });
+
+    if (rounds % 2 == 1) {
+        val.swap(val_b);
+    }
+}
+
+// turns an inclusive scan into an exclusive one given the original
+// predecessors.
+template<class T, class Index>
+std::vector<T> exclusive_from_inclusive(const std::vector<Index>& pred,
+                                        const std::vector<T>& incl,
+                                        const T& identity)
+{
+    std::vector<T> excl(incl.size());
+    for (size_t i = 0; i < incl.size(); ++i) {
+        excl[i] = pred[i] == Index(-1) ? identity : incl[pred[i]];
+    }
+    return excl;
+}
+
+// prefix scan of the data of the list beginning at `start`, in list order,
+// using pointer jumping rounds across `threads` worker threads.
+// `threads == 0` uses the hardware concurrency.
+template<class T, class BinaryOp>
+std::vector<T> list_scan_parallel(const node* start, BinaryOp op, T identity,
+                                  unsigned threads,
+                                  scan_kind kind = scan_kind::inclusive)
+{
+    std::vector<T> val;
+    std::vector<size_t> pred;
+    for (const node* n = start; n; n = n == n->next ? nullptr : n->next) {
+        pred.push_back(val.empty() ? size_t(-1) : val.size() - 1);
+        val.push_back(T(n->data));
+    }
+    if (kind == scan_kind::inclusive) {
+        wyllie_scan(pred, val, op, threads);
+        return val;
+    }
+    std::vector<size_t> pred0 = pred;
+    wyllie_scan(pred, val, op, threads);
+    return exclusive_from_inclusive(pred0, val, identity);
+}
+
+// the same in one sequential walk, O(n) where the wyllie rounds do
+// O(n log(n)) work.
+template<class T, class BinaryOp>
+std::vector<T> list_scan(const node* start, BinaryOp op, T identity,
+                         scan_kind kind = scan_kind::inclusive)
+{
+    std::vector<T> out;
+    T acc = identity;
+    for (const node* n = start; n; n = n == n->next ? nullptr : n->next) {
+        if (kind == scan_kind::exclusive) {
+            out.push_back(acc);
+        }
+        acc = n == start ? T(n->data) : op(acc, T(n->data));
+        if (kind == scan_kind::inclusive) {
+            out.push_back(acc);
+        }
+    }
+    return out;
+}
+
+// prefix scan of an index list in list order from `lst.head`, keyed by element
+// index. every element must be on the chain from `lst.head`.
+template<class T, class BinaryOp>
+std::vector<T> list_scan_parallel(const index_list& lst, BinaryOp op,
+                                  T identity, unsigned threads,
+                                  scan_kind kind = scan_kind::inclusive)
+{
+    const size_t n = lst.next.size();
+    std::vector<T> val(lst.data.begin(), lst.data.end());
+    std::vector<uint32_t> pred(n, uint32_t(-1));
+    for (size_t i = 0; i < n; ++i) {
+        if (lst.next[i] != i) {
+            pred[lst.next[i]] = i;
+        }
+    }
+    if (kind == scan_kind::inclusive) {
+        wyllie_scan(pred, val, op, threads);
+        return val;
+    }
+    std::vector<uint32_t> pred0 = pred;
+    wyllie_scan(pred, val, op, threads);
+    return exclusive_from_inclusive(pred0, val, identity);
+}
+
+// the same in one sequential walk from `lst.head`.
+template<class T, class BinaryOp>
+std::vector<T> list_scan(const index_list& lst, BinaryOp op, T identity,
+                         scan_kind kind = scan_kind::inclusive)
+{
+    std::vector<T> out(lst.data.size(), identity);
+    if (lst.empty()) {
+        return out;
+    }
+    T acc = identity;
+    uint32_t i = lst.head;
+    while (true) {
+        if (kind == scan_kind::exclusive) {
+            out[i] = acc;
+        }
+        acc = i == lst.head ? T(lst.data[i]) : op(acc, T(lst.data[i]));
+        if (kind == scan_kind::inclusive) {
+            out[i] = acc;
+        }
+        if (i == lst.next[i]) {
+            break;
+        }
+        i = lst.next[i];
+    }
+    return out;
+}
+
+#endif
@@ -0,0 +1,226 @@
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "linked_list.hpp"
+#include "node_pool.hpp"
+
+namespace {
+
+struct free_block {
+    free_block* next;
+};
+
+// a chain of free blocks
+struct block_chain {
+    free_block* head;
+    size_t count;
+};
+
+// blocks carved from the system at once
+const size_t slab_blocks = 4096;
+
+struct shared_pool {
+    std::mutex mtx;
+    std::vector<block_chain> batches;
+    // kept so the slabs stay reachable for leak checkers
+    std::vector<void*> slabs;
+};
+
+// never destroyed, so the shared pool is still usable during static
+// destruction
+shared_pool& shared()
+{
+    static shared_pool* pool = new shared_pool;
+    return *pool;
+}
+
+struct local_cache {
+    free_block* head = nullptr;
+    size_t count = 0;
+
+    // hands the blocks of an exiting thread back to the shared pool.
+    //
+    // the cache is left empty: destructors that run later on the same thread
+    // (e.g. static destructors on the main thread) may still allocate or free
+    // nodes through it, and must not reuse blocks the pool now owns.
+    ~local_cache()
+    {
+        if (count > 0) {
+            shared_pool& pool = shared();
+            std::lock_guard<std::mutex> lock(pool.mtx);
+            pool.batches.push_back({head, count});
+        }
+        head = nullptr;
+        count = 0;
+    }
+};
+
+thread_local local_cache cache;
+
+void refill()
+{
+    shared_pool& pool = shared();
+    {
+        std::lock_guard<std::mutex> lock(pool.mtx);
+        if (!pool.batches.empty()) {
+            block_chain b = pool.batches.back();
+            pool.batches.pop_back();
+            cache.head = b.head;
+            cache.count = b.count;
+            return;
+        }
+    }
+    char* slab =
+        static_cast<char*>(::operator new(slab_blocks * node_pool_block_size));
+    {
+        std::lock_guard<std::mutex> lock(pool.mtx);
+        pool.slabs.push_back(slab);
+    }
+    for (size_t i = slab_blocks; i > 0; --i) {
+        auto* b = reinterpret_cast<free_block*>(
+            slab + (i - 1) * node_pool_block_size);
+        b->next = cache.head;
+        cache.head = b;
+    }
+    cache.count = slab_blocks;
+}
+
+// gives one batch of the local free list to the shared pool, keeping the most
+// recently freed (and likely cached) batch local
+void spill()
+{
+    free_block* keep = cache.head;
+    for (size_t i = 1; i < node_pool_batch_size; ++i) {
+        keep = keep->next;
+    }
+    free_block* first = keep->next;
+    free_block* last = first;
+    for (size_t i = 1; i < node_pool_batch_size; ++i) {
+        last = last->next;
+    }
+    keep->next = last->next;
+    cache.count -= node_pool_batch_size;
+    last->next = nullptr;
+
+    shared_pool& pool = shared();
+    std::lock_guard<std::mutex> lock(pool.mtx);
+    pool.batches.push_back({first, node_pool_batch_size});
+}
+
+} // namespace
+
+static_assert(node_pool_block_size >= sizeof(free_block),
+              "blocks too small to hold a free list link");
+static_assert(sizeof(node) <= node_pool_block_size, "nodes aren't pooled");
+
+void* node_pool_allocate()
+{
+    if (!cache.head) {
+        refill();
+    }
+    free_block* b = cache.head;
+    cache.head = b->next;
+    --cache.count;
+    return b;
+}
+
+void node_pool_deallocate(void* p)
+{
+    auto* b = static_cast<free_block*>(p);
+    b->next = cache.head;
+    cache.head = b;
+    if (++cache.count >= 2 * node_pool_batch_size) {
+        spill();
+    }
+}
+
+size_t node_pool_local_free() { return cache.count; }
+
+#ifdef TESTING
+#include "doctest.h"
+#include <atomic>
+#include <set>
+#include <thread>
+
+TEST_CASE("node_pool")
+{
+    SUBCASE("reuse")
+    {
+        node* a = new node(1);
+        delete a;
+        // the freed block is at the top of the local free list
+        node* b = new node(2);
+        CHECK(a == b);
+        delete b;
+    }
+    SUBCASE("distinct blocks")
+    {
+        std::set<node*> seen;
+        std::vector<node*> nodes;
+        for (int i = 0; i < 10000; ++i) {
+            nodes.push_back(new node(i));
+            CHECK(seen.insert(nodes.back()).second);
+        }
+        for (node* n : nodes) {
+            delete n;
+        }
+    }
+    SUBCASE("bounded local free list")
+    {
+        node* lst = make_list(10 * node_pool_batch_size);
+        delete lst;
+        CHECK(node_pool_local_free() < 2 * node_pool_batch_size);
+    }
+    SUBCASE("use after the thread's cache is destroyed")
+    {
+        // thread_locals are destroyed in reverse order of construction, so
+        // this one, constructed before the thread first touches the pool,
+        // outlives the thread's cache
+        static std::atomic<size_t> left{1};
+        struct late {
+            ~late()
+            {
+                left = node_pool_local_free();
+                node* a = new node(1);
+                node* b = new node(2);
+                CHECK(a != b);
+                delete a;
+                delete b;
+            }
+        };
+        std::thread t([] {
+            thread_local late guard;
+            (void)guard;
+            delete make_list(100);
+        });
+        t.join();
+        CHECK(left == 0);
+    }
+    SUBCASE("cross-thread churn")
+    {
+        // lists built on one thread and freed on another
+        std::vector<node*> lists(8);
+        std::thread maker([&] {
+            for (size_t i = 0; i < lists.size(); ++i) {
+                lists[i] = make_list(1000 + i);
+            }
+        });
+        maker.join();
+        std::vector<std::thread> workers;
+        for (node*& l : lists) {
+            workers.emplace_back([&l] {
+                CHECK(node::size(l) >= 1000);
+                delete l;
+                node* again = make_list(500);
+                CHECK(node::size(again) == 500);
+                delete again;
+            });
+        }
+        for (auto& t : workers) {
+            t.join();
+        }
+    }
+}
+
+#endif
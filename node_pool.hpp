@@ -0,0 +1,30 @@
+#ifndef NODE_POOL_HPP
+#define NODE_POOL_HPP
+
+#include <cstddef>
+
+// fixed-size block allocator backing `basic_node::operator new`.
+//
+// each thread allocates from and frees to its own free list without locking.
+// a thread that frees more than it allocates hands blocks back to a shared
+// pool in batches, and a thread whose free list runs dry takes a batch from
+// the shared pool before carving a new slab. memory is never returned to the
+// system, it stays in the pool for reuse.
+
+// the size of every block, enough for a node with an int or an out-of-line
+// payload. larger nodes are allocated with ::operator new.
+constexpr size_t node_pool_block_size = 2 * sizeof(void*);
+
+// blocks moved between a thread and the shared pool at once.
+constexpr size_t node_pool_batch_size = 1024;
+
+// returns one uninitialized block.
+void* node_pool_allocate();
+
+// returns a block from `node_pool_allocate` to the calling thread's free list.
+void node_pool_deallocate(void* p);
+
+// the number of blocks on the calling thread's free list.
+size_t node_pool_local_free();
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// reusable barrier for a fixed number of threads (c++17 has no std::barrier).
+class barrier {
+public:
+    explicit barrier(unsigned count) : count(count), waiting(0), generation(0)
+    {
+    }
+
+    // blocks until `count` threads have called wait.
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        unsigned gen = generation;
+        if (++waiting == count) {
+            waiting = 0;
+            ++generation;
+            cv.notify_all();
+        }
+        else {
+            cv.wait(lock, [&] { return gen != generation; });
+        }
+    }
+
+private:
+    std::mutex mtx;
+    std::condition_variable cv;
+    const unsigned count;
+    unsigned waiting;
+    unsigned generation;
+};
+
+// the thread count to use when the caller asks for 0 threads.
+inline unsigned default_threads()
+{
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw ? hw : 1;
+}
+
+// the half-open range [first, second) of `n` items owned by thread `tid` of
+// `nthreads`, split as evenly as possible.
+inline std::pair<size_t, size_t> block_range(size_t n, unsigned tid,
+                                             unsigned nthreads)
+{
+    return {n * tid / nthreads, n * (tid + 1) / nthreads};
+}
+
+// runs `fn(tid, nthreads, sync)` on `nthreads` threads (the calling thread is
+// thread 0) and waits for all of them. `sync` is a barrier shared by all the
+// workers, so `fn` can run several synchronous rounds without respawning.
+template<class F>
+void run_threads(unsigned nthreads, F&& fn)
+{
+    if (nthreads == 0) {
+        nthreads = default_threads();
+    }
+    barrier sync(nthreads);
+    std::vector<std::thread> workers;
+    workers.reserve(nthreads - 1);
+    for (unsigned tid = 1; tid < nthreads; ++tid) {
+        workers.emplace_back([&, tid] { fn(tid, nthreads, sync); });
+    }
+    fn(0u, nthreads, sync);
+    for (auto& t : workers) {
+        t.join();
+    }
+}
+
+#endif
@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "simd_jump.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_JUMP_X86
+#include <immintrin.h>
+#endif
+
+// one jumping round over all `n` elements: out[i] = in[in[i]]. returns whether
+// any element changed, i.e. whether the list hasn't converged yet.
+using round_fn = bool (*)(const uint32_t* in, uint32_t* out, size_t n);
+
+static bool round_scalar(const uint32_t* in, uint32_t* out, size_t n)
+{
+    uint32_t diff = 0;
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = in[in[i]];
+        diff |= out[i] ^ in[i];
+    }
+    return diff != 0;
+}
+
+#ifdef SIMD_JUMP_X86
+
+__attribute__((target("avx2"))) static bool
+round_avx2(const uint32_t* in, uint32_t* out, size_t n)
+{
+    const int* base = reinterpret_cast<const int*>(in);
+    __m256i diff = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i idx = _mm256_loadu_si256((const __m256i*)(in + i));
+        __m256i got = _mm256_i32gather_epi32(base, idx, 4);
+        _mm256_storeu_si256((__m256i*)(out + i), got);
+        diff = _mm256_or_si256(diff, _mm256_xor_si256(got, idx));
+    }
+    uint32_t d = 0;
+    for (; i < n; ++i) {
+        out[i] = in[in[i]];
+        d |= out[i] ^ in[i];
+    }
+    return !_mm256_testz_si256(diff, diff) || d != 0;
+}
+
+__attribute__((target("avx512f"))) static bool
+round_avx512(const uint32_t* in, uint32_t* out, size_t n)
+{
+    __mmask16 diff = 0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512i idx = _mm512_loadu_si512(in + i);
+        // the masked form avoids a gcc warning about the unmasked form's
+        // undefined passthrough operand
+        __m512i got = _mm512_mask_i32gather_epi32(_mm512_setzero_si512(),
+                                                  0xffff, idx, in, 4);
+        _mm512_storeu_si512(out + i, got);
+        diff |= _mm512_cmpneq_epi32_mask(got, idx);
+    }
+    uint32_t d = 0;
+    for (; i < n; ++i) {
+        out[i] = in[in[i]];
+        d |= out[i] ^ in[i];
+    }
+    return diff != 0 || d != 0;
+}
+
+#endif
+
+simd_level detect_simd()
+{
+#ifdef SIMD_JUMP_X86
+    if (__builtin_cpu_supports("avx512f")) {
+        return simd_level::avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return simd_level::avx2;
+    }
+#endif
+    return simd_level::scalar;
+}
+
+const char* simd_level_name(simd_level level)
+{
+    switch (level) {
+    case simd_level::avx512:
+        return "avx512";
+    case simd_level::avx2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
+
+static round_fn pick_round(simd_level level, size_t n)
+{
+    // gather indices are signed 32-bit
+    if (n > size_t(std::numeric_limits<int32_t>::max())) {
+        return round_scalar;
+    }
+    level = std::min(level, detect_simd());
+#ifdef SIMD_JUMP_X86
+    switch (level) {
+    case simd_level::avx512:
+        return round_avx512;
+    case simd_level::avx2:
+        return round_avx2;
+    default:
+        break;
+    }
+#endif
+    return round_scalar;
+}
+
+size_t do_ptr_jump_simd(index_list& lst, simd_level level)
+{
+    const size_t n = lst.next.size();
+    round_fn round = pick_round(level, n);
+    std::vector<uint32_t> buf(n);
+    uint32_t* in = lst.next.data();
+    uint32_t* out = buf.data();
+    const size_t max_rounds = jump_rounds(n) + 1;
+    size_t rounds = 0;
+    bool changed = n > 0;
+    while (changed && rounds < max_rounds) {
+        changed = round(in, out, n);
+        std::swap(in, out);
+        ++rounds;
+    }
+    if (in == buf.data()) {
+        lst.next.swap(buf);
+    }
+    if (changed) {
+        throw std::domain_error("cycle in list");
+    }
+    return rounds;
+}
+
+#ifdef TESTING
+#include "doctest.h"
+#include <string>
+
+TEST_CASE("do_ptr_jump_simd")
+{
+    std::vector<simd_level> levels{simd_level::scalar};
+    if (detect_simd() >= simd_level::avx2) {
+        levels.push_back(simd_level::avx2);
+    }
+    if (detect_simd() >= simd_level::avx512) {
+        levels.push_back(simd_level::avx512);
+    }
+    for (simd_level level : levels) {
+        std::string name = simd_level_name(level);
+        CAPTURE(name);
+        SUBCASE("in order")
+        {
+            for (size_t len : {0, 1, 2, 5, 15, 16, 17, 1000, 1025}) {
+                CAPTURE(len);
+                index_list lst = make_index_list(len);
+                size_t rounds = do_ptr_jump_simd(lst, level);
+                for (size_t i = 0; i < len; ++i) {
+                    CHECK(lst.next[i] == len - 1);
+                }
+                // the head is len - 1 hops from the terminal, so it takes
+                // ceil(log2(len - 1)) rounds plus the one that sees no change
+                size_t expect = 0;
+                while (len > 1 && (size_t(1) << expect) < len - 1) {
+                    ++expect;
+                }
+                CHECK(rounds == (len ? expect + 1 : 0));
+            }
+        }
+        SUBCASE("cycle")
+        {
+            // cycles whose length isn't a power of two; those collapse into
+            // self-loops
+            for (size_t len : {3, 17, 1000}) {
+                CAPTURE(len);
+                index_list lst = make_index_list(len);
+                lst.next[len - 1] = len / 2 - 1;
+                CHECK_THROWS_AS(do_ptr_jump_simd(lst, level),
+                                std::domain_error);
+            }
+        }
+        SUBCASE("permuted")
+        {
+            const size_t len = 4099;
+            index_list lst = make_permuted_index_list(len, 1);
+            uint32_t terminal = lst.head;
+            while (lst.next[terminal] != terminal) {
+                terminal = lst.next[terminal];
+            }
+            do_ptr_jump_simd(lst, level);
+            for (size_t i = 0; i < len; ++i) {
+                CHECK(lst.next[i] == terminal);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef SIMD_JUMP_HPP
+#define SIMD_JUMP_HPP
+
+#include "index_list.hpp"
+
+// vectorized pointer jumping on index lists.
+//
+// a jumping round `next[i] = next[next[i]]` over the 32-bit successor array is
+// a gather, so on x86 it runs 8 (avx2) or 16 (avx-512) elements at a time.
+// the instruction set is picked at runtime from what the cpu supports, with a
+// scalar fallback everywhere else.
+
+enum class simd_level { scalar, avx2, avx512 };
+
+// the best level the running cpu supports.
+simd_level detect_simd();
+
+// the name of a level, for reports.
+const char* simd_level_name(simd_level level);
+
+// redirects every element to the terminal like `do_ptr_jump(index_list&)`,
+// with vectorized rounds at `level` (clamped to what the cpu supports).
+//
+// rather than a fixed ceil(log2(n)) rounds, it stops after the first round
+// that changes nothing; that check is folded into the vectorized round.
+// returns the number of rounds run.
+//
+// a well-formed list converges within `jump_rounds(n) + 1` rounds. one that
+// runs into a cycle never does, so after that many rounds it throws
+// `std::domain_error`, leaving the successors partly jumped. (a cycle whose
+// length is a power of two is the exception: jumping collapses it into
+// self-loops, which look like terminals.)
+size_t do_ptr_jump_simd(index_list& lst, simd_level level = detect_simd());
+
+#endif
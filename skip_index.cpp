@@ -0,0 +1,68 @@
+#include <stdexcept>
+
+#include "skip_index.hpp"
+
+skip_index::skip_index(node* start, size_t k) : k(k), len(0)
+{
+    if (k == 0) {
+        throw std::invalid_argument("stride must be > 0");
+    }
+    for (node* n = start; n; n = n == n->next ? nullptr : n->next) {
+        if (len % k == 0) {
+            stops.push_back(n);
+        }
+        ++len;
+    }
+}
+
+node* skip_index::at(size_t idx) const
+{
+    if (len == 0) {
+        throw std::out_of_range("empty list");
+    }
+    if (idx >= len) {
+        throw std::out_of_range("index >= size");
+    }
+    node* tgt = stops[idx / k];
+    for (size_t i = idx % k; i > 0; --i) {
+        tgt = tgt->next;
+    }
+    return tgt;
+}
+
+#ifdef TESTING
+#include "doctest.h"
+
+TEST_CASE("skip_index")
+{
+    SUBCASE("zero-element")
+    {
+        skip_index idx(nullptr, 4);
+        CHECK(idx.size() == 0);
+        CHECK_THROWS_AS(idx.at(0), std::out_of_range);
+    }
+    SUBCASE("matches node::at")
+    {
+        for (size_t k : {1, 2, 3, 64}) {
+            CAPTURE(k);
+            for (size_t len : {1, 2, 5, 100}) {
+                CAPTURE(len);
+                node* foo = make_list(len);
+                skip_index idx(foo, k);
+                CHECK(idx.size() == len);
+                for (size_t i = 0; i < len; ++i) {
+                    CHECK(idx.at(i) == node::at(foo, i));
+                }
+                CHECK_THROWS_AS(idx.at(len), std::out_of_range);
+                CHECK_THROWS_AS(idx.at(len + k), std::out_of_range);
+                delete foo;
+            }
+        }
+    }
+    SUBCASE("zero stride")
+    {
+        CHECK_THROWS_AS(skip_index(nullptr, 0), std::invalid_argument);
+    }
+}
+
+#endif
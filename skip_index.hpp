@@ -0,0 +1,32 @@
+#ifndef SKIP_INDEX_HPP
+#define SKIP_INDEX_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "linked_list.hpp"
+
+// side index of every k-th node of a list, turning `node::at` into at most
+// k - 1 hops after an O(1) lookup.
+//
+// the index is a snapshot: it must be rebuilt if the list is changed.
+class skip_index {
+public:
+    // indexes the list beginning at `start` in one walk. `k` must be > 0.
+    explicit skip_index(node* start, size_t k = 64);
+
+    // bounds-checked element access with the same `std::out_of_range`
+    // behaviour as `node::at`
+    node* at(size_t idx) const;
+
+    size_t size() const { return len; }
+    size_t stride() const { return k; }
+
+private:
+    // stops[i] is node i * k
+    std::vector<node*> stops;
+    size_t k;
+    size_t len;
+};
+
+#endif
@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "parallel.hpp"
+#include "successor_table.hpp"
+
+successor_table::successor_table(const index_list& lst, unsigned level_stride,
+                                 unsigned threads)
+    : n(lst.next.size()), nlevels(0), level_stride(level_stride)
+{
+    if (level_stride == 0) {
+        throw std::invalid_argument("level stride must be > 0");
+    }
+    if (n == 0) {
+        return;
+    }
+    if (threads == 0) {
+        threads = default_threads();
+    }
+
+    // no element is more than n - 1 hops from the terminal, so levels past
+    // 2^l >= n - 1 would all be the terminal
+    size_t full_levels = 1;
+    while (full_levels < 64 && (size_t{1} << full_levels) < n - 1) {
+        ++full_levels;
+    }
+    nlevels = (full_levels + level_stride - 1) / level_stride;
+    table.resize(nlevels * n);
+    std::copy(lst.next.begin(), lst.next.end(), table.begin());
+
+    // the skipped levels are jumped through in two scratch buffers
+    std::vector<uint32_t> scratch_a;
+    std::vector<uint32_t> scratch_b;
+    if (level_stride > 1) {
+        scratch_a.resize(n);
+        scratch_b.resize(n);
+    }
+
+    run_threads(threads, [&](unsigned tid, unsigned nthreads, barrier& sync) {
+        auto [lo, hi] = block_range(n, tid, nthreads);
+        for (size_t l = 1; l < nlevels; ++l) {
+            const uint32_t* prev = table.data() + (l - 1) * n;
+            uint32_t* cur = table.data() + l * n;
+            const uint32_t* in = prev;
+            for (unsigned r = 0; r < level_stride; ++r) {
+                // the last round of a level writes straight into the table
+                uint32_t* out = r + 1 == level_stride ? cur
+                                : r % 2 == 0          ? scratch_a.data()
+                                                      : scratch_b.data();
+                for (size_t i = lo; i < hi; ++i) {
+                    out[i] = in[in[i]];
+                }
+                sync.wait();
+                in = out;
+            }
+        }
+    });
+}
+
+uint32_t successor_table::successor(uint32_t idx, size_t k) const
+{
+    if (idx >= n) {
+        throw std::out_of_range("index >= size");
+    }
+    // every element reaches the terminal within n - 1 hops
+    k = std::min(k, n - 1);
+    for (size_t l = nlevels; l-- > 0 && k > 0;) {
+        const size_t span = size_t{1} << (l * level_stride);
+        const uint32_t* level = table.data() + l * n;
+        while (k >= span) {
+            idx = level[idx];
+            k -= span;
+        }
+    }
+    return idx;
+}
+
+#ifdef TESTING
+#include "doctest.h"
+
+// the element `k` hops after `idx`, one hop at a time
+static uint32_t walk(const index_list& lst, uint32_t idx, size_t k)
+{
+    for (; k > 0 && lst.next[idx] != idx; --k) {
+        idx = lst.next[idx];
+    }
+    return idx;
+}
+
+TEST_CASE("successor_table")
+{
+    SUBCASE("empty")
+    {
+        index_list lst;
+        successor_table tbl(lst);
+        CHECK(tbl.size() == 0);
+        CHECK(tbl.levels() == 0);
+        CHECK_THROWS_AS(tbl.successor(0, 0), std::out_of_range);
+    }
+    SUBCASE("zero stride")
+    {
+        index_list lst = make_index_list(4);
+        CHECK_THROWS_AS(successor_table(lst, 0), std::invalid_argument);
+    }
+    SUBCASE("matches walking")
+    {
+        for (size_t len : {1, 2, 3, 5, 64, 65, 300}) {
+            CAPTURE(len);
+            // scramble the element order so indices and positions differ
+            index_list lst = make_permuted_index_list(len, 7);
+            for (unsigned stride : {1u, 2u, 3u, 7u}) {
+                CAPTURE(stride);
+                for (unsigned threads : {1u, 3u}) {
+                    CAPTURE(threads);
+                    successor_table tbl(lst, stride, threads);
+                    CHECK(tbl.size() == len);
+                    CHECK(tbl.stride() == stride);
+                    for (uint32_t i = 0; i < len; ++i) {
+                        for (size_t k : {size_t{0}, size_t{1}, size_t{2},
+                                         size_t{5}, size_t{63}, size_t{64},
+                                         len / 2, len - 1, len, len * 3}) {
+                            CHECK(tbl.successor(i, k) == walk(lst, i, k));
+                        }
+                    }
+                    CHECK_THROWS_AS(tbl.successor(len, 0), std::out_of_range);
+                }
+            }
+        }
+    }
+    SUBCASE("striding keeps fewer levels")
+    {
+        index_list lst = make_index_list(1 << 10);
+        CHECK(successor_table(lst, 1).levels() == 10);
+        CHECK(successor_table(lst, 2).levels() == 5);
+        CHECK(successor_table(lst, 4).levels() == 3);
+    }
+}
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef SUCCESSOR_TABLE_HPP
+#define SUCCESSOR_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "index_list.hpp"
+
+// binary lifting table of an index list's successors, answering "which element
+// is k hops after element i" in O(log(k)) lookups instead of the k hops
+// `index_list::at` would walk. hops stop at the terminal, like pointer
+// jumping. only useful where element indices differ from list positions: on
+// a list numbered in list order (like `index_list::from_nodes` makes) the
+// answer is just min(i + k, n - 1).
+//
+// level l of the full table holds every element's 2^l-th successor and is
+// built from level l - 1 by one pointer jumping round. with a `level_stride`
+// of s only every s-th level is kept, cutting the memory by s in exchange for
+// up to 2^s - 1 lookups per kept level.
+//
+// the table is a snapshot: it must be rebuilt if the list is changed.
+class successor_table {
+public:
+    // builds the table across `threads` worker threads. `level_stride` must
+    // be > 0. `threads == 0` uses the hardware concurrency.
+    explicit successor_table(const index_list& lst, unsigned level_stride = 1,
+                             unsigned threads = 1);
+
+    // the element `k` hops after element `idx`. throws `std::out_of_range` if
+    // `idx` isn't an element.
+    uint32_t successor(uint32_t idx, size_t k) const;
+
+    // number of elements
+    size_t size() const { return n; }
+    // number of levels kept
+    size_t levels() const { return nlevels; }
+    unsigned stride() const { return level_stride; }
+
+private:
+    // level-major: table[l * n + i] is the 2^(l * level_stride)-th successor
+    // of element i
+    std::vector<uint32_t> table;
+    size_t n;
+    size_t nlevels;
+    unsigned level_stride;
+};
+
+#endif
@@ -0,0 +1,136 @@
+#include <stdexcept>
+
+#include "traversal.hpp"
+
+// lists walked in lockstep; enough misses in flight to cover the memory
+// latency without running out of registers.
+static const size_t group_size = 16;
+
+std::vector<size_t> size_batch(node* const* starts, size_t n)
+{
+    std::vector<size_t> sizes(n, 0);
+    for (size_t g = 0; g < n; g += group_size) {
+        // cursors of the lists in this group that haven't finished
+        node* cur[group_size];
+        size_t which[group_size];
+        size_t live = 0;
+        for (size_t i = g; i < n && i < g + group_size; ++i) {
+            if (starts[i]) {
+                sizes[i] = 1;
+                cur[live] = starts[i];
+                which[live] = i;
+                ++live;
+            }
+        }
+        while (live > 0) {
+            for (size_t j = 0; j < live;) {
+                node* c = cur[j];
+                if (c == c->next) {
+                    // done: swap in the last live cursor
+                    --live;
+                    cur[j] = cur[live];
+                    which[j] = which[live];
+                    continue;
+                }
+                c = c->next;
+                __builtin_prefetch(c);
+                cur[j] = c;
+                ++sizes[which[j]];
+                ++j;
+            }
+        }
+    }
+    return sizes;
+}
+
+std::vector<node*> at_batch(node* const* starts, const size_t* indices,
+                            size_t n)
+{
+    std::vector<node*> found(n);
+    for (size_t g = 0; g < n; g += group_size) {
+        node* cur[group_size];
+        size_t left[group_size];
+        size_t which[group_size];
+        size_t live = 0;
+        for (size_t i = g; i < n && i < g + group_size; ++i) {
+            if (!starts[i]) {
+                throw std::out_of_range("empty list");
+            }
+            found[i] = starts[i];
+            if (indices[i] > 0) {
+                cur[live] = starts[i];
+                left[live] = indices[i];
+                which[live] = i;
+                ++live;
+            }
+        }
+        while (live > 0) {
+            for (size_t j = 0; j < live;) {
+                node* c = cur[j];
+                // bounds check
+                if (c == c->next) {
+                    throw std::out_of_range("index >= size");
+                }
+                c = c->next;
+                __builtin_prefetch(c);
+                if (--left[j] == 0) {
+                    found[which[j]] = c;
+                    --live;
+                    cur[j] = cur[live];
+                    left[j] = left[live];
+                    which[j] = which[live];
+                    continue;
+                }
+                cur[j] = c;
+                ++j;
+            }
+        }
+    }
+    return found;
+}
+
+#ifdef TESTING
+#include "doctest.h"
+
+TEST_CASE("traversal batches")
+{
+    std::vector<node*> lists;
+    for (size_t len : {0, 1, 2, 5, 40, 3, 0, 17, 100, 1, 64, 2, 9, 33, 8, 7,
+                       12, 1000, 4}) {
+        lists.push_back(make_list(len));
+    }
+    SUBCASE("size_batch")
+    {
+        auto sizes = size_batch(lists.data(), lists.size());
+        REQUIRE(sizes.size() == lists.size());
+        for (size_t i = 0; i < lists.size(); ++i) {
+            CHECK(sizes[i] == node::size(lists[i]));
+        }
+        CHECK(size_batch(nullptr, 0).empty());
+    }
+    SUBCASE("at_batch")
+    {
+        std::vector<node*> nonempty;
+        std::vector<size_t> idx;
+        for (node* l : lists) {
+            if (l) {
+                nonempty.push_back(l);
+                idx.push_back(node::size(l) / 2);
+            }
+        }
+        auto found = at_batch(nonempty.data(), idx.data(), nonempty.size());
+        for (size_t i = 0; i < nonempty.size(); ++i) {
+            CHECK(found[i] == node::at(nonempty[i], idx[i]));
+        }
+        idx.back() = node::size(nonempty.back());
+        CHECK_THROWS_AS(at_batch(nonempty.data(), idx.data(), idx.size()),
+                        std::out_of_range);
+        CHECK_THROWS_AS(at_batch(lists.data(), idx.data(), 1),
+                        std::out_of_range);
+    }
+    for (node* l : lists) {
+        delete l;
+    }
+}
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef TRAVERSAL_HPP
+#define TRAVERSAL_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "linked_list.hpp"
+
+// batched traversal kernels for many lists at once.
+//
+// walking one list is a chain of dependent loads, so the cpu waits out a full
+// cache miss per hop. these walk a group of lists in lockstep, one hop of each
+// per pass, so the misses of independent lists overlap; each hop also
+// prefetches the node the next pass will read.
+
+// `node::size` of each of the `n` lists beginning at `starts[i]`.
+std::vector<size_t> size_batch(node* const* starts, size_t n);
+
+// `node::at(starts[i], indices[i])` for each of the `n` lists, with the same
+// `std::out_of_range` behaviour.
+std::vector<node*> at_batch(node* const* starts, const size_t* indices,
+                            size_t n);
+
+#endif
@@ -0,0 +1,215 @@
+#include <stdexcept>
+
+#include "unrolled_list.hpp"
+
+// appends `d` to the list ending at `tail`, returning the new tail
+static unrolled_block* push_back(unrolled_block* tail, int d)
+{
+    if (tail->count == unrolled_block::capacity) {
+        tail->next = new unrolled_block;
+        tail = tail->next;
+    }
+    tail->data[tail->count++] = d;
+    return tail;
+}
+
+unrolled_block* make_unrolled_list(size_t nelts)
+{
+    if (nelts < 1) {
+        return nullptr;
+    }
+    unrolled_block* root = new unrolled_block;
+    unrolled_block* tail = root;
+    for (size_t i = 0; i < nelts; ++i) {
+        tail = push_back(tail, i);
+    }
+    return root;
+}
+
+unrolled_block* make_unrolled_list(std::initializer_list<int> lst)
+{
+    if (lst.size() == 0) {
+        return nullptr;
+    }
+    unrolled_block* root = new unrolled_block;
+    unrolled_block* tail = root;
+    for (int d : lst) {
+        tail = push_back(tail, d);
+    }
+    return root;
+}
+
+int& unrolled_block::at(unrolled_block* start, size_t idx)
+{
+    if (!start) {
+        throw std::out_of_range("empty list");
+    }
+    unrolled_block* tgt = start;
+    // whole blocks can be skipped without looking at their elements
+    while (idx >= tgt->count) {
+        if (tgt == tgt->next) {
+            throw std::out_of_range("index >= size");
+        }
+        idx -= tgt->count;
+        tgt = tgt->next;
+    }
+    return tgt->data[idx];
+}
+
+size_t unrolled_block::size(unrolled_block* start)
+{
+    if (!start) {
+        return 0;
+    }
+    unrolled_block* curr = start;
+    size_t sz = curr->count;
+    while (curr->next != curr) {
+        curr = curr->next;
+        sz += curr->count;
+    }
+    return sz;
+}
+
+size_t unrolled_block::blocks(unrolled_block* start)
+{
+    if (!start) {
+        return 0;
+    }
+    unrolled_block* curr = start;
+    size_t n = 1;
+    while (curr->next != curr) {
+        ++n;
+        curr = curr->next;
+    }
+    return n;
+}
+
+std::ostream& operator<<(std::ostream& os, const unrolled_block* b)
+{
+    os << '{';
+    bool first = true;
+    while (b) {
+        for (uint32_t i = 0; i < b->count; ++i) {
+            if (!first) {
+                os << ", ";
+            }
+            os << b->data[i];
+            first = false;
+        }
+        b = b == b->next ? nullptr : b->next;
+    }
+    return os << '}';
+}
+
+std::vector<unrolled_block*> do_ptr_jump(unrolled_block* start)
+{
+    std::vector<unrolled_block*> refs;
+    if (!start) {
+        return refs;
+    }
+    unrolled_block* n = start;
+    while (n != n->next) {
+        refs.push_back(n);
+        n = n->next;
+    }
+    refs.push_back(n);
+
+    // n is the terminal block
+    for (unrolled_block* r : refs) {
+        r->next = n;
+    }
+    return refs;
+}
+
+void do_jumped_delete(std::vector<unrolled_block*>& lst)
+{
+    if (lst.size() == 0) {
+        return;
+    }
+    unrolled_block* terminal = lst[0]->next;
+    for (unrolled_block* b : lst) {
+        if (b->next != terminal) {
+            throw std::domain_error("deleting non-jumped list");
+        }
+    }
+    for (unrolled_block* b : lst) {
+        // ensure terminal is only deleted once.
+        b->next = b;
+        delete b;
+    }
+}
+
+#ifdef TESTING
+#include "doctest.h"
+#include "linked_list.hpp"
+#include <sstream>
+
+TEST_CASE("unrolled_list")
+{
+    const size_t cap = unrolled_block::capacity;
+    SUBCASE("make_unrolled_list(size_t)")
+    {
+        CHECK(make_unrolled_list(0) == nullptr);
+        CHECK(unrolled_block::size(nullptr) == 0);
+        CHECK_THROWS_AS(unrolled_block::at(nullptr, 0), std::out_of_range);
+
+        for (size_t len : {size_t(1), cap, cap + 1, 10 * cap + 3}) {
+            CAPTURE(len);
+            unrolled_block* foo = make_unrolled_list(len);
+            CHECK(unrolled_block::size(foo) == len);
+            CHECK(unrolled_block::blocks(foo) == (len + cap - 1) / cap);
+            for (size_t i = 0; i < len; ++i) {
+                CHECK(unrolled_block::at(foo, i) == int(i));
+            }
+            CHECK_THROWS_AS(unrolled_block::at(foo, len), std::out_of_range);
+            delete foo;
+        }
+    }
+    SUBCASE("make_unrolled_list(initializer_list<int>)")
+    {
+        CHECK(make_unrolled_list({}) == nullptr);
+        unrolled_block* foo = make_unrolled_list({-100, 14, 2, 0, 0xbeef});
+        CHECK(unrolled_block::size(foo) == 5);
+        CHECK(unrolled_block::at(foo, 0) == -100);
+        CHECK(unrolled_block::at(foo, 4) == 0xbeef);
+        unrolled_block::at(foo, 1) = 15;
+        CHECK(unrolled_block::at(foo, 1) == 15);
+        delete foo;
+    }
+    SUBCASE("operator<<")
+    {
+        for (size_t len : {0, 1, 5, 40}) {
+            CAPTURE(len);
+            unrolled_block* foo = make_unrolled_list(len);
+            node* bar = make_list(len);
+            std::ostringstream a, b;
+            a << foo;
+            b << bar;
+            CHECK(a.str() == b.str());
+            delete foo;
+            delete bar;
+        }
+    }
+    SUBCASE("do_ptr_jump")
+    {
+        CHECK(do_ptr_jump(static_cast<unrolled_block*>(nullptr)).empty());
+        unrolled_block* foo = make_unrolled_list(10 * cap);
+        auto refs = do_ptr_jump(foo);
+        REQUIRE(refs.size() == 10);
+        for (unrolled_block* b : refs) {
+            CHECK(b->next == refs.back());
+        }
+        // the terminal block's elements are one hop from the head
+        CHECK(unrolled_block::at(foo, cap) == int(9 * cap));
+        do_jumped_delete(refs);
+    }
+    SUBCASE("do_jumped_delete non-jumped")
+    {
+        unrolled_block* foo = make_unrolled_list(3 * cap);
+        std::vector<unrolled_block*> refs{foo, foo->next, foo->next->next};
+        CHECK_THROWS_AS(do_jumped_delete(refs), std::domain_error);
+        delete foo;
+    }
+}
+
+#endif
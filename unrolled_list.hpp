@@ -0,0 +1,71 @@
+#ifndef UNROLLED_LIST_HPP
+#define UNROLLED_LIST_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <ostream>
+#include <vector>
+
+// unrolled linked list: each block fills one cache line with as many elements
+// as fit next to the block-level `next` pointer, so traversal takes one
+// dependent miss per block instead of one per element.
+//
+// every block except the terminal is full, and like `node` the terminal block
+// points to itself.
+struct alignas(64) unrolled_block {
+    static constexpr size_t capacity =
+        (64 - sizeof(void*) - sizeof(uint32_t)) / sizeof(int);
+
+    unrolled_block* next;
+    uint32_t count;
+    int data[capacity];
+
+    unrolled_block() : next(this), count(0) {}
+
+    // deleting a block deletes all the blocks after it, iteratively like
+    // `node`
+    ~unrolled_block()
+    {
+        unrolled_block* n = next;
+        while (n != this) {
+            unrolled_block* after = n->next;
+            bool terminal = n == after;
+            n->next = n;
+            delete n;
+            if (terminal) {
+                break;
+            }
+            n = after;
+        }
+    }
+
+    // bounds-checked element access
+    static int& at(unrolled_block* start, size_t idx);
+
+    // returns the number of elements in the list beginning at `start`
+    static size_t size(unrolled_block* start);
+
+    // returns the number of blocks in the list beginning at `start`
+    static size_t blocks(unrolled_block* start);
+
+    friend std::ostream& operator<<(std::ostream&, const unrolled_block*);
+};
+
+static_assert(sizeof(unrolled_block) == 64, "block should be one cache line");
+
+// create an unrolled list with data elements 0..nelts
+unrolled_block* make_unrolled_list(size_t nelts);
+// create an unrolled list with the given data elements
+unrolled_block* make_unrolled_list(std::initializer_list<int> lst);
+
+// pointer jumping at block granularity: every block is redirected to the
+// terminal block. returns every block in list order so they can be deleted
+// with `do_jumped_delete`.
+std::vector<unrolled_block*> do_ptr_jump(unrolled_block* start);
+
+// deletes the blocks of a jumped unrolled list. throws `std::domain_error` if
+// the list isn't jumped.
+void do_jumped_delete(std::vector<unrolled_block*>& lst);
+
+#endif
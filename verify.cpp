@@ -0,0 +1,210 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "parallel.hpp"
+#include "verify.hpp"
+
+#if defined(__x86_64__)
+#define VERIFY_X86
+#include <immintrin.h>
+#endif
+
+// the first index in [lo, hi) whose node doesn't point at `terminal`, or `hi`.
+// `offset` is where `next` sits within a node, for the gathers.
+using scan_fn = size_t (*)(node* const* refs, size_t lo, size_t hi,
+                           const node* terminal, size_t offset);
+
+static size_t scan_scalar(node* const* refs, size_t lo, size_t hi,
+                          const node* terminal, size_t)
+{
+    for (size_t i = lo; i < hi; ++i) {
+        if (refs[i]->next != terminal) {
+            return i;
+        }
+    }
+    return hi;
+}
+
+#ifdef VERIFY_X86
+
+__attribute__((target("avx2"))) static size_t
+scan_avx2(node* const* refs, size_t lo, size_t hi, const node* terminal,
+          size_t offset)
+{
+    const __m256i want = _mm256_set1_epi64x(reinterpret_cast<intptr_t>(terminal));
+    const __m256i off = _mm256_set1_epi64x(offset);
+    size_t i = lo;
+    for (; i + 4 <= hi; i += 4) {
+        // the node addresses plus `offset` are the addresses of their `next`
+        __m256i addr = _mm256_add_epi64(
+            _mm256_loadu_si256((const __m256i*)(refs + i)), off);
+        __m256i got = _mm256_i64gather_epi64(nullptr, addr, 1);
+        __m256i eq = _mm256_cmpeq_epi64(got, want);
+        unsigned bad = ~_mm256_movemask_pd(_mm256_castsi256_pd(eq)) & 0xf;
+        if (bad) {
+            return i + __builtin_ctz(bad);
+        }
+    }
+    return scan_scalar(refs, i, hi, terminal, offset);
+}
+
+__attribute__((target("avx512f"))) static size_t
+scan_avx512(node* const* refs, size_t lo, size_t hi, const node* terminal,
+            size_t offset)
+{
+    const __m512i want = _mm512_set1_epi64(reinterpret_cast<intptr_t>(terminal));
+    const __m512i off = _mm512_set1_epi64(offset);
+    size_t i = lo;
+    for (; i + 8 <= hi; i += 8) {
+        __m512i addr = _mm512_add_epi64(_mm512_loadu_si512(refs + i), off);
+        // masked for the same gcc warning as in simd_jump.cpp
+        __m512i got = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), 0xff,
+                                                  addr, nullptr, 1);
+        __mmask8 bad = _mm512_cmpneq_epi64_mask(got, want);
+        if (bad) {
+            return i + __builtin_ctz(bad);
+        }
+    }
+    return scan_scalar(refs, i, hi, terminal, offset);
+}
+
+#endif
+
+static scan_fn pick_scan(simd_level level)
+{
+    level = std::min(level, detect_simd());
+#ifdef VERIFY_X86
+    switch (level) {
+    case simd_level::avx512:
+        return scan_avx512;
+    case simd_level::avx2:
+        return scan_avx2;
+    default:
+        break;
+    }
+#endif
+    return scan_scalar;
+}
+
+// threads only pay off once each has this many nodes to check
+static constexpr size_t min_per_thread = size_t(1) << 16;
+// how many nodes a thread checks between looking for an earlier offender
+static constexpr size_t chunk = 4096;
+
+size_t verify_jumped(const std::vector<node*>& refs, unsigned threads,
+                     simd_level level)
+{
+    const size_t n = refs.size();
+    if (n == 0) {
+        return 0;
+    }
+    if (threads == 0) {
+        threads = default_threads();
+    }
+    threads = unsigned(std::max<size_t>(
+        1, std::min<size_t>(threads, n / min_per_thread)));
+
+    const node* terminal = refs[0]->next;
+    const size_t offset = reinterpret_cast<const char*>(&refs[0]->next) -
+                          reinterpret_cast<const char*>(refs[0]);
+    scan_fn scan = pick_scan(level);
+    std::atomic<size_t> first{n};
+
+    run_threads(threads, [&](unsigned tid, unsigned nthreads, barrier&) {
+        auto [lo, hi] = block_range(n, tid, nthreads);
+        for (size_t i = lo; i < hi; i += chunk) {
+            if (first.load(std::memory_order_relaxed) < i) {
+                return;
+            }
+            size_t end = std::min(hi, i + chunk);
+            size_t bad = scan(refs.data(), i, end, terminal, offset);
+            if (bad < end) {
+                size_t cur = first.load(std::memory_order_relaxed);
+                while (bad < cur && !first.compare_exchange_weak(cur, bad)) {
+                }
+                return;
+            }
+        }
+    });
+    return first.load();
+}
+
+void assert_jumped(const std::vector<node*>& refs, unsigned threads)
+{
+    size_t bad = verify_jumped(refs, threads);
+    if (bad < refs.size()) {
+        throw std::domain_error("node " + std::to_string(bad) +
+                                " doesn't point at the terminal");
+    }
+}
+
+#ifdef TESTING
+#include "doctest.h"
+
+TEST_CASE("verify_jumped")
+{
+    std::vector<simd_level> levels{simd_level::scalar};
+    if (detect_simd() >= simd_level::avx2) {
+        levels.push_back(simd_level::avx2);
+    }
+    if (detect_simd() >= simd_level::avx512) {
+        levels.push_back(simd_level::avx512);
+    }
+    for (simd_level level : levels) {
+        std::string name = simd_level_name(level);
+        CAPTURE(name);
+        SUBCASE("empty")
+        {
+            std::vector<node*> refs;
+            CHECK(verify_jumped(refs, 1, level) == 0);
+            CHECK_NOTHROW(assert_jumped(refs));
+        }
+        SUBCASE("first offender")
+        {
+            for (size_t len : {1, 2, 7, 9, 4096, 200'000}) {
+                CAPTURE(len);
+                std::vector<node*> refs = do_ptr_jump(make_list(len));
+                for (unsigned threads : {1u, 4u}) {
+                    CAPTURE(threads);
+                    CHECK(verify_jumped(refs, threads, level) == len);
+                }
+                // the terminal is last, so it points at itself instead of
+                // at the terminal only if it's broken too
+                std::vector<size_t> bads;
+                for (size_t bad : {size_t{1}, len / 3, len - 1}) {
+                    if (bad > 0 && bad < len) {
+                        bads.push_back(bad);
+                    }
+                }
+                for (size_t bad : bads) {
+                    CAPTURE(bad);
+                    node* was = refs[bad]->next;
+                    refs[bad]->next = bad == len - 1 ? refs[0] : refs[bad];
+                    for (unsigned threads : {1u, 4u}) {
+                        CAPTURE(threads);
+                        CHECK(verify_jumped(refs, threads, level) == bad);
+                    }
+                    CHECK_THROWS_AS(assert_jumped(refs), std::domain_error);
+                    refs[bad]->next = was;
+                }
+                // with several offenders the earliest is reported, whichever
+                // thread finds it
+                for (size_t bad : bads) {
+                    refs[bad]->next = bad == len - 1 ? refs[0] : refs[bad];
+                }
+                if (!bads.empty()) {
+                    CHECK(verify_jumped(refs, 4, level) == bads[0]);
+                }
+                for (node* n : refs) {
+                    n->next = refs.back();
+                }
+                do_jumped_delete(refs);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef VERIFY_HPP
+#define VERIFY_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "linked_list.hpp"
+#include "simd_jump.hpp"
+
+// checks that jumping worked: every node in `refs` (as returned by
+// `do_ptr_jump`) must point at the same terminal as `refs[0]`.
+//
+// returns the index of the first node that doesn't, or `refs.size()` if they
+// all do. the scan is split across `threads` worker threads (fewer for short
+// vectors) and gathers the `next` pointers several nodes at a time at `level`
+// (clamped to what the cpu supports); a thread stops early once an offender
+// before its block is known. `threads == 0` uses the hardware concurrency.
+size_t verify_jumped(const std::vector<node*>& refs, unsigned threads = 0,
+                     simd_level level = detect_simd());
+
+// the same as an assertion: throws `std::domain_error` naming the first
+// offending index if `refs` isn't jumped. cheap enough to leave on in
+// production where a corrupt list must not go unnoticed.
+void assert_jumped(const std::vector<node*>& refs, unsigned threads = 0);
+
+#endif